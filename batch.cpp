@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+
+#include "board.h"
+#include "corpus.h"
+#include "render.h"
+#include "sudoku.h"
+
+// Renders the step trace of every puzzle in a corpus without a terminal. A corpus is a text file with one puzzle per
+// line, 81 characters in row order, anything but 1-9 being an empty cell; empty lines and lines starting with '#' are
+// skipped. ANSI and HTML traces go to stdout (or --out FILE) one frame after another; SVG writes one file per frame
+// into the --out directory.
+//
+// With --dedup, writes the corpus back instead, sorted by PackedPuzzle::relabelKey and with one puzzle per key, i.e.
+// per set of puzzles that are the same up to digit names.
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--format ansi|html|svg | --dedup] [--out PATH] [CORPUS]\n", argv0);
+    exit(2);
+}
+
+static void write_or_die(FILE *f, const char *s, size_t len) {
+    if (fwrite(s, 1, len, f) != len) {
+        perror("write");
+        exit(1);
+    }
+}
+
+static void write_or_die(FILE *f, const std::string &s) { write_or_die(f, s.data(), s.size()); }
+
+static int dedup(const char *in, FILE *fout) {
+    PackedCorpus corpus;
+    if (!corpus.load((in && strcmp(in, "-") != 0) ? in : "/dev/stdin")) {
+        perror(in);
+        return 1;
+    }
+    corpus.sortByRelabelKey();
+
+    uint8_t key[PackedPuzzle::BYTES];
+    uint8_t last[PackedPuzzle::BYTES];
+    char line[82];
+    for (size_t i = 0; i < corpus.size(); i++) {
+        corpus[i].relabelKey(key);
+        if (i > 0 && memcmp(key, last, sizeof(key)) == 0) continue;
+        memcpy(last, key, sizeof(key));
+
+        corpus[i].str(line);
+        line[81] = '\n';
+        write_or_die(fout, line, sizeof(line));
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *format = "ansi";
+    const char *out    = nullptr;
+    const char *in     = nullptr;
+    bool dedup_only    = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+            format = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            out = argv[++i];
+        else if (strcmp(argv[i], "--dedup") == 0)
+            dedup_only = true;
+        else if (argv[i][0] == '-' && argv[i][1] != 0)
+            usage(argv[0]);
+        else
+            in = argv[i];
+    }
+
+    std::unique_ptr<FrameRenderer> renderer;
+    if (strcmp(format, "ansi") == 0)
+        renderer = std::make_unique<AnsiRenderer>();
+    else if (strcmp(format, "html") == 0)
+        renderer = std::make_unique<HtmlRenderer>();
+    else if (strcmp(format, "svg") == 0)
+        renderer = std::make_unique<SvgRenderer>();
+    else
+        usage(argv[0]);
+
+    bool per_frame_files = !dedup_only && strcmp(format, "svg") == 0;
+    if (per_frame_files && !out) usage(argv[0]);
+
+    FILE *fin = (in && strcmp(in, "-") != 0) ? fopen(in, "r") : stdin;
+    if (!fin) {
+        perror(in);
+        return 1;
+    }
+    FILE *fout = (out && !per_frame_files) ? fopen(out, "w") : stdout;
+    if (!fout) {
+        perror(out);
+        return 1;
+    }
+
+    if (dedup_only) {
+        if (fin != stdin) fclose(fin);
+        int ret = dedup(in, fout);
+        if (fout != stdout) fclose(fout);
+        return ret;
+    }
+
+    Board board(*renderer);
+    char title[64];
+    char path[4096];
+    char *line     = nullptr;
+    size_t linecap = 0;
+    int puzzle     = 0;
+
+    write_or_die(fout, renderer->begin());
+
+    while (getline(&line, &linecap, fin) > 0) {
+        if (line[0] == '\n' || line[0] == '\r' || line[0] == '#') continue;
+        puzzle++;
+
+        Sudoku sudoku(line);
+        Sudoku next(sudoku);
+        for (int step = 0;; step++) {
+            board.draw(next);
+            snprintf(title, sizeof(title), "puzzle %d step %d", puzzle, step);
+            const std::string &frame = renderer->frame(title);
+
+            if (per_frame_files) {
+                snprintf(path, sizeof(path), "%s/%06d-%04d.svg", out, puzzle, step);
+                FILE *f = fopen(path, "w");
+                if (!f) {
+                    perror(path);
+                    return 1;
+                }
+                write_or_die(f, frame);
+                fclose(f);
+            } else {
+                write_or_die(fout, frame);
+            }
+
+            if (!sudoku.calcOneStep(next)) break;
+        }
+    }
+
+    write_or_die(fout, renderer->end());
+
+    free(line);
+    if (fout != stdout) fclose(fout);
+    if (fin != stdin) fclose(fin);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "corpus.h"
+#include "lanes.h"
+#include "parallel.h"
+#include "sudoku.h"
+#include "transposition.h"
+
+// Solves every puzzle of a corpus to its fixpoint, `--rounds` times over, and reports the throughput. The last line is
+// what the perf gate parses, so keep its format.
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--rounds N] [--table | --lanes | --parallel] CORPUS\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    int rounds     = 10;
+    bool use_table = false;
+    bool use_lanes = false;
+    bool use_pool  = false;
+    const char *in = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc)
+            rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--table") == 0)
+            use_table = true;
+        else if (strcmp(argv[i], "--lanes") == 0)
+            use_lanes = true;
+        else if (strcmp(argv[i], "--parallel") == 0)
+            use_pool = true;
+        else if (argv[i][0] == '-')
+            usage(argv[0]);
+        else
+            in = argv[i];
+    }
+    if (!in || rounds <= 0) usage(argv[0]);
+
+    PackedCorpus puzzles;
+    if (!puzzles.load(in)) {
+        perror(in);
+        return 1;
+    }
+    if (puzzles.size() == 0) {
+        fprintf(stderr, "%s: no puzzles\n", in);
+        return 1;
+    }
+
+    // expanded before the clock starts, so that the rounds time solving alone
+    std::vector<Sudoku> sudokus;
+    sudokus.reserve(puzzles.size());
+    for (size_t i = 0; i < puzzles.size(); i++) sudokus.push_back(puzzles[i].sudoku());
+
+    auto all_done = [](const Sudoku &dst) {
+        for (int r = 0; r < 9; r++)
+            for (int c = 0; c < 9; c++)
+                if (!dst.onlyOneCandidate(r, c)) return false;
+        return true;
+    };
+
+    int solved = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds && use_lanes; round++) {
+        LaneSolver lanes;
+        size_t taken = 0;
+        solved       = 0;
+        lanes.run(
+            [&](Sudoku &dst) {
+                if (taken == sudokus.size()) return false;
+                dst = sudokus[taken++];
+                return true;
+            },
+            [&](size_t, Sudoku &dst) {
+                if (all_done(dst)) solved++;
+            });
+    }
+    for (int round = 0; round < rounds && !use_lanes; round++) {
+        // a fresh table every round, so that rounds after the first do not just replay the first
+        std::unique_ptr<TranspositionTable> table;
+        if (use_table) table = std::make_unique<TranspositionTable>();
+        std::unique_ptr<StepPool> pool;
+        if (use_pool) pool = std::make_unique<StepPool>();
+
+        solved = 0;
+        for (size_t i = 0; i < sudokus.size(); i++) {
+            const Sudoku &puzzle = sudokus[i];
+            Sudoku dst(puzzle);
+            if (pool)
+                while (pool->calcOneStep(dst)) {}
+            else
+                puzzle.calcFixpoint(dst, table.get());
+            if (all_done(dst)) solved++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("puzzles %zu rounds %d solved %d seconds %.3f\n", puzzles.size(), rounds, solved, seconds);
+    printf("puzzles/sec %.1f\n", puzzles.size() * rounds / seconds);
+    return 0;
+}
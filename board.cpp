@@ -7,7 +7,7 @@
 #include <functional>
 #include <vector>
 
-#include "screen.h"
+#include "canvas.h"
 
 // https://unicode-table.com/en/blocks/box-drawing/
 const static char *HORIZENTAL         = "\u2500";
@@ -30,7 +30,7 @@ const static char *CROSS              = "\u253C";
 const static char *CROSS_THICK        = "\u256C";
 const static char *BLANK              = " ";
 
-void Board::draw(const Sudoku &sudoku) {
+void Board::draw(const Sudoku &sudoku, const BoardMarks *marks) {
     const int ROW_N0 = 3;
     const int ROW_N1 = ROW_N0 + 1;
     const int ROW_N2 = 3 * ROW_N1;
@@ -47,64 +47,70 @@ void Board::draw(const Sudoku &sudoku) {
                 ; /* empty to align codes */
 
             else if (r == 0 && c == 0)
-                screen.draw(r, c, LEFT_UP_THICK, BG_COLOR_DEFAULT);
+                put(r, c, LEFT_UP_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == 0 && c == COL_N3)
-                screen.draw(r, c, RIGHT_UP_THICK, BG_COLOR_DEFAULT);
+                put(r, c, RIGHT_UP_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == 0 && (c % COL_N2) == 0)
-                screen.draw(r, c, UP_THICK, BG_COLOR_DEFAULT);
+                put(r, c, UP_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == 0 && (c % COL_N1) == 0)
-                screen.draw(r, c, UP_THICK, BG_COLOR_DEFAULT);
+                put(r, c, UP_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == 0)
-                screen.draw(r, c, HORIZENTAL_THICK, BG_COLOR_DEFAULT);
+                put(r, c, HORIZENTAL_THICK, COLOR_INDEX_DEFAULT_COLOR);
 
             else if (r == ROW_N3 && c == 0)
-                screen.draw(r, c, LEFT_BOTTOM_THICK, BG_COLOR_DEFAULT);
+                put(r, c, LEFT_BOTTOM_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == ROW_N3 && c == COL_N3)
-                screen.draw(r, c, RIGHT_BOTTOM_THICK, BG_COLOR_DEFAULT);
+                put(r, c, RIGHT_BOTTOM_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == ROW_N3 && (c % COL_N2) == 0)
-                screen.draw(r, c, BOTTOM_THICK, BG_COLOR_DEFAULT);
+                put(r, c, BOTTOM_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == ROW_N3 && (c % COL_N1) == 0)
-                screen.draw(r, c, BOTTOM_THICK, BG_COLOR_DEFAULT);
+                put(r, c, BOTTOM_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if (r == ROW_N3)
-                screen.draw(r, c, HORIZENTAL_THICK, BG_COLOR_DEFAULT);
+                put(r, c, HORIZENTAL_THICK, COLOR_INDEX_DEFAULT_COLOR);
 
             else if ((r % ROW_N2) == 0 && c == 0)
-                screen.draw(r, c, LEFT_THICK, BG_COLOR_DEFAULT);
+                put(r, c, LEFT_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N2) == 0 && c == COL_N3)
-                screen.draw(r, c, RIGHT_THICK, BG_COLOR_DEFAULT);
+                put(r, c, RIGHT_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N2) == 0 && (c % COL_N2) == 0)
-                screen.draw(r, c, CROSS_THICK, BG_COLOR_DEFAULT);
+                put(r, c, CROSS_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N2) == 0 && (c % COL_N1) == 0)
-                screen.draw(r, c, CROSS_THICK, BG_COLOR_DEFAULT);
+                put(r, c, CROSS_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N2) == 0)
-                screen.draw(r, c, HORIZENTAL_THICK, BG_COLOR_DEFAULT);
+                put(r, c, HORIZENTAL_THICK, COLOR_INDEX_DEFAULT_COLOR);
 
             else if ((r % ROW_N1) == 0 && c == 0)
-                screen.draw(r, c, LEFT_THICK, BG_COLOR_DEFAULT);
+                put(r, c, LEFT_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N1) == 0 && c == COL_N3)
-                screen.draw(r, c, RIGHT_THICK, BG_COLOR_DEFAULT);
+                put(r, c, RIGHT_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N1) == 0 && (c % COL_N2) == 0)
-                screen.draw(r, c, CROSS_THICK, BG_COLOR_DEFAULT);
+                put(r, c, CROSS_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N1) == 0 && (c % COL_N1) == 0)
-                screen.draw(r, c, CROSS, BG_COLOR_DEFAULT);
+                put(r, c, CROSS, COLOR_INDEX_DEFAULT_COLOR);
             else if ((r % ROW_N1) == 0)
-                screen.draw(r, c, HORIZENTAL, BG_COLOR_DEFAULT);
+                put(r, c, HORIZENTAL, COLOR_INDEX_DEFAULT_COLOR);
 
             else if ((c % COL_N2) == 0)
-                screen.draw(r, c, VIRTICAL_THICK, BG_COLOR_DEFAULT);
+                put(r, c, VIRTICAL_THICK, COLOR_INDEX_DEFAULT_COLOR);
             else if ((c % COL_N1) == 0)
-                screen.draw(r, c, VIRTICAL, BG_COLOR_DEFAULT);
+                put(r, c, VIRTICAL, COLOR_INDEX_DEFAULT_COLOR);
 
             else {
                 int rr        = r / ROW_N1;
                 int cc        = c / COL_N1;
                 bool done     = sudoku.onlyOneCandidate(rr, cc);
                 bool original = sudoku.original(rr, cc);
+                bool conflict = marks && marks->conflict[rr][cc];
+                bool cursor   = marks && marks->cursor.r == rr && marks->cursor.c == cc;
 
                 auto color_index = [&](int n) {
                     bool isreason = sudoku.isreason(rr, cc, n);
 
-                    if (original && !isreason)
+                    if (conflict)
+                        return COLOR_INDEX_CONFLICT;
+                    else if (cursor)
+                        return COLOR_INDEX_DEFAULT_COLOR_TARGET;
+                    else if (original && !isreason)
                         return COLOR_INDEX_RED;
                     else if (original && isreason)
                         return COLOR_INDEX_RED_HIGHLIGHT;
@@ -122,26 +128,30 @@ void Board::draw(const Sudoku &sudoku) {
                     ; /* empty to align codes */
 
                 else if (r % ROW_N1 == 1 && c % COL_N1 == 1 && sudoku.possible(r / ROW_N1, c / COL_N1, 1))
-                    screen.draw(r, c, "1", color_index(1));
+                    put(r, c, "1", color_index(1));
                 else if (r % ROW_N1 == 1 && c % COL_N1 == 3 && sudoku.possible(r / ROW_N1, c / COL_N1, 2))
-                    screen.draw(r, c, "2", color_index(2));
+                    put(r, c, "2", color_index(2));
                 else if (r % ROW_N1 == 1 && c % COL_N1 == 5 && sudoku.possible(r / ROW_N1, c / COL_N1, 3))
-                    screen.draw(r, c, "3", color_index(3));
+                    put(r, c, "3", color_index(3));
                 else if (r % ROW_N1 == 2 && c % COL_N1 == 1 && sudoku.possible(r / ROW_N1, c / COL_N1, 4))
-                    screen.draw(r, c, "4", color_index(4));
+                    put(r, c, "4", color_index(4));
                 else if (r % ROW_N1 == 2 && c % COL_N1 == 3 && sudoku.possible(r / ROW_N1, c / COL_N1, 5))
-                    screen.draw(r, c, "5", color_index(5));
+                    put(r, c, "5", color_index(5));
                 else if (r % ROW_N1 == 2 && c % COL_N1 == 5 && sudoku.possible(r / ROW_N1, c / COL_N1, 6))
-                    screen.draw(r, c, "6", color_index(6));
+                    put(r, c, "6", color_index(6));
                 else if (r % ROW_N1 == 3 && c % COL_N1 == 1 && sudoku.possible(r / ROW_N1, c / COL_N1, 7))
-                    screen.draw(r, c, "7", color_index(7));
+                    put(r, c, "7", color_index(7));
                 else if (r % ROW_N1 == 3 && c % COL_N1 == 3 && sudoku.possible(r / ROW_N1, c / COL_N1, 8))
-                    screen.draw(r, c, "8", color_index(8));
+                    put(r, c, "8", color_index(8));
                 else if (r % ROW_N1 == 3 && c % COL_N1 == 5 && sudoku.possible(r / ROW_N1, c / COL_N1, 9))
-                    screen.draw(r, c, "9", color_index(9));
+                    put(r, c, "9", color_index(9));
 
+                else if (conflict)
+                    put(r, c, BLANK, COLOR_INDEX_CONFLICT);
+                else if (cursor)
+                    put(r, c, BLANK, COLOR_INDEX_DEFAULT_COLOR_TARGET);
                 else
-                    screen.draw(r, c, BLANK, BG_COLOR_DEFAULT);
+                    put(r, c, BLANK, COLOR_INDEX_DEFAULT_COLOR);
             }
         }
     }
@@ -1,16 +1,31 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-#include "screen.h"
+#include "canvas.h"
 #include "sudoku.h"
 
+// Editing state drawn over a board: the cursor cell and the cells in conflict.
+struct BoardMarks {
+    RC cursor           = RCNil;
+    bool conflict[9][9] = {};
+};
+
 class Board {
 public:
-    Board(Screen &screen_) : screen(screen_) {}
-    void draw(const Sudoku &model);
+    Board(Canvas &canvas_, int top_ = 0, int left_ = 0) : canvas(canvas_), top(top_), left(left_) {}
+    void draw(const Sudoku &model, const BoardMarks *marks = nullptr);
+
+    const static int HEIGHT = 4 * 9 + 1;
+    const static int WIDTH  = 6 * 9 + 1;
 
 private:
-    Screen &screen;
+    Canvas &canvas;
+    const int top;
+    const int left;
+
+    inline void put(int r, int c, const char *str, int color_index) {
+        canvas.draw(top + r, left + c, str, color_index);
+    }
 };
 
 #endif  // BOARD_H
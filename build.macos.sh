@@ -3,6 +3,12 @@ g++ \
     ./board.cpp\
     ./screen.cpp\
     ./sudoku.cpp\
+    ./transposition.cpp\
+    ./corpus.cpp\
+    ./tile.cpp\
+    ./hint.cpp\
+    ./parallel.cpp\
+    ./editor.cpp\
     --std=c++17\
     -lncurses\
     -g\
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Profile guided, link time optimized build: instrument, train on the reference corpus, rebuild with the profile.
+#   ./build.pgo.sh [BUILD_DIR] [extra cmake args, e.g. -DSUDOKU_MARCH=native]
+set -e
+
+BUILD_DIR=${1:-build-pgo}
+[ $# -gt 0 ] && shift
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+PGO_DIR=$(mkdir -p "$BUILD_DIR/pgo" && cd "$BUILD_DIR/pgo" && pwd)
+
+rm -f "$PGO_DIR"/*.profraw "$PGO_DIR"/*.profdata
+find "$PGO_DIR" -name '*.gcda' -delete
+
+cmake -S "$SRC_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DSUDOKU_LTO=ON \
+    -DSUDOKU_PGO=GENERATE -DSUDOKU_PGO_DIR="$PGO_DIR" "$@"
+cmake --build "$BUILD_DIR" -j
+"$BUILD_DIR/sudoku-bench" --rounds 3 "$SRC_DIR/bench/reference.txt"
+"$BUILD_DIR/sudoku-bench" --rounds 3 --table "$SRC_DIR/bench/reference.txt"
+"$BUILD_DIR/sudoku-bench" --rounds 3 --lanes "$SRC_DIR/bench/reference.txt"
+
+if ls "$PGO_DIR"/*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -output="$PGO_DIR/merged.profdata" "$PGO_DIR"/*.profraw
+fi
+
+cmake -S "$SRC_DIR" -B "$BUILD_DIR" -DSUDOKU_PGO=USE
+cmake --build "$BUILD_DIR" -j
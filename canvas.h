@@ -0,0 +1,23 @@
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#define COLOR_INDEX_DEFAULT_COLOR 0
+#define COLOR_INDEX_RED 1
+#define COLOR_INDEX_DEFAULT_HIGHLIGHT 2
+#define COLOR_INDEX_YELLOW 3
+#define COLOR_INDEX_DEFAULT_COLOR_CANDIDATE 4
+#define COLOR_INDEX_RED_HIGHLIGHT 5
+#define COLOR_INDEX_DEFAULT_COLOR_TARGET 6
+#define COLOR_INDEX_YELLOW_HIGHLIGHT 7
+#define COLOR_INDEX_CONFLICT 8
+#define COLOR_INDEX_CNT 9
+
+// Something a Board can be drawn on: one glyph (a UTF-8 string) at a time, at a row/column, in one of the color
+// indexes above. Screen draws to the terminal, the renderers in render.h draw to memory.
+class Canvas {
+public:
+    virtual ~Canvas() {}
+    virtual void draw(int r, int c, const char *str, int color_index) = 0;
+};
+
+#endif  // CANVAS_H
@@ -0,0 +1,50 @@
+# Runs sudoku-bench on the reference corpus and compares its puzzles/sec with a recorded baseline.
+#
+#   cmake -DBENCH=... -DCORPUS=... -DBASELINE=... [-DTHRESHOLD=10] [-DRECORD=ON] -P perf_gate.cmake
+#
+# With RECORD, the measurement becomes the new baseline. Otherwise it fails when puzzles/sec dropped by more than
+# THRESHOLD percent. The best of RUNS runs is used, to keep a busy machine from failing the gate.
+
+if(NOT DEFINED THRESHOLD)
+    set(THRESHOLD 10)
+endif()
+if(NOT DEFINED RUNS)
+    set(RUNS 5)
+endif()
+if(NOT DEFINED ROUNDS)
+    set(ROUNDS 10)
+endif()
+
+set(best 0)
+foreach(run RANGE 1 ${RUNS})
+    execute_process(
+        COMMAND ${BENCH} --rounds ${ROUNDS} ${CORPUS}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${BENCH} failed: ${result}")
+    endif()
+    if(NOT output MATCHES "puzzles/sec ([0-9]+)")
+        message(FATAL_ERROR "unexpected benchmark output:\n${output}")
+    endif()
+    if(CMAKE_MATCH_1 GREATER best)
+        set(best ${CMAKE_MATCH_1})
+    endif()
+endforeach()
+
+if(RECORD)
+    file(WRITE ${BASELINE} "${best}\n")
+    message(STATUS "perf baseline: ${best} puzzles/sec, written to ${BASELINE}")
+    return()
+endif()
+
+if(NOT EXISTS ${BASELINE})
+    message(FATAL_ERROR "no baseline at ${BASELINE}; record one with the perf-baseline target")
+endif()
+file(STRINGS ${BASELINE} baseline LIMIT_COUNT 1)
+
+math(EXPR floor "${baseline} * (100 - ${THRESHOLD}) / 100")
+if(best LESS floor)
+    message(FATAL_ERROR "perf regression: ${best} puzzles/sec, baseline ${baseline}, floor ${floor} (-${THRESHOLD}%)")
+endif()
+message(STATUS "perf gate passed: ${best} puzzles/sec, baseline ${baseline}, floor ${floor} (-${THRESHOLD}%)")
@@ -0,0 +1,149 @@
+#include "corpus.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+CorpusFile::CorpusFile(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        size = 1;  // not ok()
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        size  = st.st_size;
+        inode = st.st_ino;
+#ifdef __APPLE__
+        mtime = st.st_mtimespec.tv_sec * 1000000000ULL + st.st_mtimespec.tv_nsec;
+#else
+        mtime = st.st_mtim.tv_sec * 1000000000ULL + st.st_mtim.tv_nsec;
+#endif
+    }
+    if (size > 0) {
+        void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) data = (const char *)p;
+    }
+    close(fd);
+}
+
+CorpusFile::~CorpusFile() {
+    if (data) munmap((void *)data, size);
+}
+
+bool CorpusFile::scan_one() {
+    while (data && scanned < size) {
+        size_t begin   = scanned;
+        const char *nl = (const char *)memchr(data + begin, '\n', size - begin);
+        scanned        = nl ? (nl - data) + 1 : size;
+
+        if (data[begin] == '\n' || data[begin] == '\r' || data[begin] == '#') continue;
+        offsets.push_back(begin);
+        return true;
+    }
+    return false;
+}
+
+bool CorpusFile::puzzle(size_t i, char buf[82]) {
+    while (offsets.size() <= i)
+        if (!scan_one()) return false;
+
+    size_t begin = offsets[i];
+    int len      = 0;
+    for (; len < 81 && begin + len < size && data[begin + len] != '\n'; len++) buf[len] = data[begin + len];
+    buf[len] = 0;
+    return true;
+}
+
+void PackedPuzzle::relabelKey(uint8_t key[BYTES]) const {
+    uint8_t rename[10] = {};
+    uint8_t next       = 1;
+    memset(key, 0, BYTES);
+    for (int i = 0; i < 81; i++) {
+        int n = at(i);
+        if (n && !rename[n]) rename[n] = next++;
+        key[i / 2] |= rename[n] << (i % 2 * 4);
+    }
+}
+
+void PackedCorpus::add(const char *puzzle) {
+    size_t at = buf.size();
+    buf.resize(at + PackedPuzzle::BYTES);
+    for (int i = 0; i < 81 && puzzle[i] && puzzle[i] != '\n'; i++)
+        if ('1' <= puzzle[i] && puzzle[i] <= '9') buf[at + i / 2] |= (puzzle[i] - '0') << (i % 2 * 4);
+}
+
+bool PackedCorpus::load(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+
+    char *line     = nullptr;
+    size_t linecap = 0;
+    while (getline(&line, &linecap, f) > 0) {
+        if (line[0] == '\n' || line[0] == '\r' || line[0] == '#') continue;
+        add(line);
+    }
+
+    free(line);
+    fclose(f);
+    return true;
+}
+
+void PackedCorpus::sortByRelabelKey(int threads) {
+    const int BYTES = PackedPuzzle::BYTES;
+    size_t n        = size();
+
+    std::vector<uint8_t> keys(n * BYTES);
+    forEachParallel([&](size_t i, PackedPuzzle puzzle) { puzzle.relabelKey(&keys[i * BYTES]); }, threads);
+
+    std::vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = i;
+    auto less = [&](uint32_t a, uint32_t b) {
+        int cmp = memcmp(&keys[(size_t)a * BYTES], &keys[(size_t)b * BYTES], BYTES);
+        return cmp != 0 ? cmp < 0 : a < b;
+    };
+
+    // sort one range per thread, then merge the ranges pairwise
+    threads = std::max(1, std::min(threads, (int)std::min<size_t>(n, 64)));
+    std::vector<size_t> bounds;
+    for (int t = 0; t <= threads; t++) bounds.push_back(n * t / threads);
+    {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++)
+            workers.emplace_back([&, t] { std::sort(order.data() + bounds[t], order.data() + bounds[t + 1], less); });
+        for (auto &worker : workers) worker.join();
+    }
+    for (size_t width = 1; width < (size_t)threads; width *= 2) {
+        for (size_t t = 0; t + width < (size_t)threads; t += 2 * width) {
+            size_t end = std::min((size_t)threads, t + 2 * width);
+            std::inplace_merge(
+                order.begin() + bounds[t], order.begin() + bounds[t + width], order.begin() + bounds[end], less);
+        }
+    }
+
+    keys.clear();
+    keys.shrink_to_fit();
+
+    // position i gets the puzzle at order[i]; follow each cycle of the permutation once
+    uint8_t tmp[BYTES];
+    for (size_t i = 0; i < n; i++) {
+        if (order[i] == i) continue;
+        memcpy(tmp, &buf[i * BYTES], BYTES);
+        size_t j = i;
+        while (true) {
+            size_t k = order[j];
+            order[j] = j;
+            if (k == i) {
+                memcpy(&buf[j * BYTES], tmp, BYTES);
+                break;
+            }
+            memcpy(&buf[j * BYTES], &buf[k * BYTES], BYTES);
+            j = k;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "sudoku.h"
+
+// Read-only view of a corpus file: one puzzle per line, 81 characters in row order, anything but 1-9 being an empty
+// cell; empty lines and lines starting with '#' are skipped. The file is mapped, not read, and lines are indexed only
+// as far as they have been asked for, so opening a file of any size is instant.
+class CorpusFile {
+    const char *data = nullptr;
+    size_t size      = 0;
+    size_t scanned   = 0;         // bytes indexed so far
+    std::vector<size_t> offsets;  // of the puzzle lines found so far
+    uint64_t inode = 0;
+    uint64_t mtime = 0;  // ns
+
+    bool scan_one();
+
+public:
+    explicit CorpusFile(const char *path);
+    ~CorpusFile();
+    CorpusFile(const CorpusFile &) = delete;
+    CorpusFile &operator=(const CorpusFile &) = delete;
+
+    inline bool ok() const { return data != nullptr || size == 0; }
+    // The whole file, for readers that split it by byte range themselves.
+    inline const char *bytes() const { return data; }
+    inline size_t byteSize() const { return data ? size : 0; }
+    // Identity of the file as opened, for telling whether it is still the same file later.
+    inline uint64_t fileInode() const { return inode; }
+    inline uint64_t fileMtimeNs() const { return mtime; }
+    // Copies puzzle i into buf as a nul terminated string; false if the file has fewer puzzles.
+    bool puzzle(size_t i, char buf[82]);
+    // Number of puzzles, if the whole file has been indexed already.
+    inline bool count(size_t &cnt) const {
+        cnt = offsets.size();
+        return scanned >= size;
+    }
+};
+
+// View of one puzzle in a PackedCorpus: the given of cell i (0 if empty) in the low nibble of byte i / 2 for even i and
+// in the high nibble for odd i. Expanding to a Sudoku is left to whoever needs one.
+class PackedPuzzle {
+    const uint8_t *p;
+
+public:
+    constexpr static int BYTES = 41;
+
+    explicit PackedPuzzle(const uint8_t *p_) : p(p_) {}
+
+    inline int at(int i) const { return (p[i / 2] >> (i % 2 * 4)) & 0xf; }
+    inline const uint8_t *bytes() const { return p; }
+    // As a corpus line, '.' for empty cells.
+    inline void str(char buf[82]) const {
+        for (int i = 0; i < 81; i++) buf[i] = at(i) ? '0' + at(i) : '.';
+        buf[81] = 0;
+    }
+    inline Sudoku sudoku() const {
+        char buf[82];
+        str(buf);
+        return Sudoku(buf);
+    }
+
+    // The puzzle with its digits renamed in order of first appearance, so that puzzles that differ only by digit
+    // names have the same key; keys compare with memcmp. Not a minlex form: rotations, reflections and row or column
+    // swaps of a puzzle get keys of their own.
+    void relabelKey(uint8_t key[BYTES]) const;
+};
+
+// Givens of many puzzles in one contiguous buffer, PackedPuzzle::BYTES (41) each, for corpora of tens of millions.
+class PackedCorpus {
+    std::vector<uint8_t> buf;
+
+public:
+    inline size_t size() const { return buf.size() / PackedPuzzle::BYTES; }
+    inline void reserve(size_t n) { buf.reserve(n * PackedPuzzle::BYTES); }
+    inline PackedPuzzle operator[](size_t i) const { return PackedPuzzle(&buf[i * PackedPuzzle::BYTES]); }
+
+    // Appends a puzzle given as a corpus line.
+    void add(const char *puzzle);
+    // Appends every puzzle of a corpus file, reading it line by line.
+    bool load(const char *path);
+
+    // Calls f(i, puzzle) for every puzzle, splitting the corpus into one contiguous range per thread.
+    template <typename F>
+    void forEachParallel(F f, int threads = std::thread::hardware_concurrency()) const {
+        size_t n     = size();
+        threads      = std::max(1, std::min(threads, (int)std::min<size_t>(n, 1024)));
+        size_t chunk = (n + threads - 1) / threads;
+
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                for (size_t i = t * chunk; i < std::min(n, (t + 1) * chunk); i++) f(i, (*this)[i]);
+            });
+        }
+        for (size_t i = 0; i < std::min(n, chunk); i++) f(i, (*this)[i]);
+        for (auto &worker : workers) worker.join();
+    }
+
+    // Sorts the puzzles by relabelKey, in place. Needs about 45 more bytes per puzzle while sorting.
+    void sortByRelabelKey(int threads = std::thread::hardware_concurrency());
+};
+
+#endif  // CORPUS_H
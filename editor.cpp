@@ -0,0 +1,64 @@
+#include "editor.h"
+
+#include <string.h>
+
+Editor::Editor(const Sudoku &start) : sudoku("") {
+    memset(given, 0, sizeof(given));
+    memset(support, 0, sizeof(support));
+    marks.cursor = {0, 0};
+
+    for (int i = 0; i < 81; i++) {
+        if (!start.original(i / 9, i % 9)) continue;
+        for (int n = 1; n <= 9; n++)
+            if (start.possible(i / 9, i % 9, n)) add_given(i, n, +1);
+    }
+    for (int i = 0; i < 81; i++) refresh(i);
+}
+
+// A given keeps its digit even when a peer has it too; that is a conflict. Other cells keep the digits no peer has.
+void Editor::refresh(int i) {
+    int r = i / 9;
+    int c = i % 9;
+
+    bool was_conflict    = marks.conflict[r][c];
+    marks.conflict[r][c] = given[i] && support[i][given[i] - 1] > 0;
+    conflicts += (int)marks.conflict[r][c] - (int)was_conflict;
+
+    unsigned short candidates = 0;
+    if (given[i]) {
+        candidates = Cell::n2v(given[i]);
+    } else {
+        for (int n = 1; n <= 9; n++)
+            if (support[i][n - 1] == 0) candidates |= Cell::n2v(n);
+    }
+    sudoku.setCell({r, c}, candidates, given[i] != 0);
+}
+
+void Editor::add_given(int i, int n, int delta) {
+    given[i]                   = delta > 0 ? n : 0;
+    const unsigned char *peers = Sudoku::peers(i);
+    for (int p = 0; p < 20; p++) support[peers[p]][n - 1] += delta;
+}
+
+bool Editor::set(int n) {
+    int i = marks.cursor.r * 9 + marks.cursor.c;
+    if (given[i] == n) return false;
+
+    if (given[i]) add_given(i, given[i], -1);
+    if (n) add_given(i, n, +1);
+
+    refresh(i);
+    const unsigned char *peers = Sudoku::peers(i);
+    for (int p = 0; p < 20; p++) refresh(peers[p]);
+    return true;
+}
+
+void Editor::move(int dr, int dc) {
+    marks.cursor.r = (marks.cursor.r + dr + 9) % 9;
+    marks.cursor.c = (marks.cursor.c + dc + 9) % 9;
+}
+
+void Editor::givens(char str[82]) const {
+    for (int i = 0; i < 81; i++) str[i] = given[i] ? '0' + given[i] : ' ';
+    str[81] = '\0';
+}
@@ -0,0 +1,35 @@
+#ifndef EDITOR_H
+#define EDITOR_H
+
+#include "board.h"
+#include "sudoku.h"
+
+// Edits the givens of a puzzle and keeps every cell's candidates consistent with them. Each cell counts, per digit,
+// the givens among its 20 peers that rule the digit out; setting or clearing a given only updates those counts and
+// the candidates of its peers, so an edit touches 21 cells whatever the state of the rest of the board.
+class Editor {
+    Sudoku sudoku;
+    unsigned char given[81];       // digit, or 0 for an empty cell
+    unsigned char support[81][9];  // peers given each digit
+    BoardMarks marks;
+    int conflicts = 0;
+
+    void refresh(int i);
+    void add_given(int i, int n, int delta);
+
+public:
+    explicit Editor(const Sudoku &start);
+
+    // Sets the given under the cursor, or clears it with 0. False if the cell already held n.
+    bool set(int n);
+    void move(int dr, int dc);
+
+    // The givens alone as a puzzle string for Sudoku(const char *), with a space for each empty cell.
+    void givens(char str[82]) const;
+
+    inline const Sudoku &board() const { return sudoku; }
+    inline const BoardMarks &boardMarks() const { return marks; }
+    inline int conflictCnt() const { return conflicts; }
+};
+
+#endif  // EDITOR_H
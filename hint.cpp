@@ -0,0 +1,46 @@
+#include "hint.h"
+
+const Hint &HintEngine::next(const Sudoku &board, std::chrono::steady_clock::duration budget, int max_techniques) {
+    auto deadline = std::chrono::steady_clock::now() + budget;
+
+    CacheEntry &cached = cache[board.hash() % CACHE_SIZE];
+    if (cached.valid && cached.hash == board.hash()) return cached.hint;
+
+    result.found     = false;
+    result.complete  = true;
+    result.tried     = 0;
+    result.technique = TECHNIQUE_CNT;
+    result.eliminations.clear();
+    result.reasons.clear();
+
+    // techniques only change dst when they apply (bar done marks), so one copy serves all of them
+    scratch = board;
+    scratch.clear_reasons();
+
+    for (int t = 0; t < TECHNIQUE_CNT; t++) {
+        if (t >= max_techniques || std::chrono::steady_clock::now() >= deadline) {
+            result.complete = false;
+            return result;
+        }
+
+        result.tried++;
+        if (!board.calcTechnique((Technique)t, scratch)) continue;
+
+        result.found     = true;
+        result.technique = (Technique)t;
+        for (int r = 0; r < 9; r++) {
+            for (int c = 0; c < 9; c++) {
+                unsigned short lost = board.candidates(r, c) & ~scratch.candidates(r, c);
+                if (lost) result.eliminations.push_back({{r, c}, lost});
+            }
+        }
+        scratch.forEachReason([this](RC rc, unsigned short v) { result.reasons.push_back({rc, v}); });
+        break;
+    }
+
+    // only complete answers are a function of the board alone
+    cached.hash  = board.hash();
+    cached.valid = true;
+    cached.hint  = result;
+    return result;
+}
@@ -0,0 +1,51 @@
+#ifndef HINT_H
+#define HINT_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "sudoku.h"
+
+// The easiest deduction available on a board, as calcOneStep would make it.
+struct Hint {
+    bool found          = false;
+    bool complete       = true;  // false if the budget ran out before every technique had been tried
+    int tried           = 0;     // techniques tried
+    Technique technique = TECHNIQUE_CNT;
+    std::vector<std::pair<RC, unsigned short>> eliminations;  // target cells and the candidates they lose
+    std::vector<std::pair<RC, unsigned short>> reasons;       // cells and candidates the deduction is based on
+};
+
+// Answers "what is the easiest next deduction here" within a budget. Techniques are tried easiest first, so the first
+// one that applies is the answer; when the budget runs out first, the hint says so with `complete` unset and what is
+// known so far (which techniques do not apply). The budget is checked between techniques, so a query can overrun it
+// by at most one technique.
+//
+// An engine keeps its scratch board, result and a small cache of answers keyed by the board's zobrist hash across
+// queries, so keep one per front end (it is not thread safe) rather than one per query.
+class HintEngine {
+    constexpr static int CACHE_SIZE = 256;
+
+    struct CacheEntry {
+        uint64_t hash = 0;
+        bool valid    = false;
+        Hint hint;
+    };
+
+    Sudoku scratch;
+    Hint result;
+    std::vector<CacheEntry> cache;
+
+public:
+    HintEngine() : scratch(""), cache(CACHE_SIZE) {}
+
+    // The result stays valid until the next call.
+    const Hint &next(const Sudoku &board,
+                     std::chrono::steady_clock::duration budget = std::chrono::milliseconds(5),
+                     int max_techniques                        = TECHNIQUE_CNT);
+};
+
+#endif  // HINT_H
@@ -0,0 +1,218 @@
+#include "lanes.h"
+
+#include <string.h>
+
+#include <vector>
+
+#if defined(__AVX512BW__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+constexpr static uint16_t ALL = (1 << 9) - 1;
+
+// The few lane-wise operations the passes need, over LANES uint16 lanes.
+#if defined(__AVX512BW__)
+typedef __m512i V;
+inline static V load(const uint16_t *p) { return _mm512_load_si512(p); }
+inline static void store(uint16_t *p, V v) { _mm512_store_si512(p, v); }
+inline static V vand(V a, V b) { return _mm512_and_si512(a, b); }
+inline static V vor(V a, V b) { return _mm512_or_si512(a, b); }
+inline static V vxor(V a, V b) { return _mm512_xor_si512(a, b); }
+inline static V andnot(V a, V b) { return _mm512_andnot_si512(a, b); }  // ~a & b
+inline static V zero() { return _mm512_setzero_si512(); }
+inline static V all() { return _mm512_set1_epi16(ALL); }
+inline static V nonzero(V a) { return _mm512_movm_epi16(_mm512_test_epi16_mask(a, a)); }
+inline static V dec(V a) { return _mm512_sub_epi16(a, _mm512_set1_epi16(1)); }
+#elif defined(__AVX2__)
+typedef __m256i V;
+inline static V load(const uint16_t *p) { return _mm256_load_si256((const __m256i *)p); }
+inline static void store(uint16_t *p, V v) { _mm256_store_si256((__m256i *)p, v); }
+inline static V vand(V a, V b) { return _mm256_and_si256(a, b); }
+inline static V vor(V a, V b) { return _mm256_or_si256(a, b); }
+inline static V vxor(V a, V b) { return _mm256_xor_si256(a, b); }
+inline static V andnot(V a, V b) { return _mm256_andnot_si256(a, b); }  // ~a & b
+inline static V zero() { return _mm256_setzero_si256(); }
+inline static V all() { return _mm256_set1_epi16(ALL); }
+inline static V nonzero(V a) {
+    return _mm256_xor_si256(_mm256_cmpeq_epi16(a, _mm256_setzero_si256()), _mm256_set1_epi16(-1));
+}
+inline static V dec(V a) { return _mm256_sub_epi16(a, _mm256_set1_epi16(1)); }
+#else
+struct V {
+    uint16_t l[LaneSolver::LANES];
+};
+#define LANEWISE(expr)                                          \
+    V r;                                                        \
+    for (int k = 0; k < LaneSolver::LANES; k++) r.l[k] = (expr); \
+    return r;
+inline static V load(const uint16_t *p) { LANEWISE(p[k]) }
+inline static void store(uint16_t *p, V v) { memcpy(p, v.l, sizeof(v.l)); }
+inline static V vand(V a, V b) { LANEWISE(a.l[k] & b.l[k]) }
+inline static V vor(V a, V b) { LANEWISE(a.l[k] | b.l[k]) }
+inline static V vxor(V a, V b) { LANEWISE(a.l[k] ^ b.l[k]) }
+inline static V andnot(V a, V b) { LANEWISE(~a.l[k] & b.l[k]) }  // ~a & b
+inline static V zero() { LANEWISE(0) }
+inline static V all() { LANEWISE(ALL) }
+inline static V nonzero(V a) { LANEWISE(a.l[k] ? 0xffff : 0) }
+inline static V dec(V a) { LANEWISE(a.l[k] - 1) }
+#undef LANEWISE
+#endif
+
+// Candidates of the cells that have exactly one, zero elsewhere.
+inline static V singles(V a) { return andnot(nonzero(vand(a, dec(a))), a); }
+
+// Cells of the 27 units, rows then columns then blocks, as r * 9 + c.
+static const struct Units {
+    unsigned char cells[27][9];
+    Units() {
+        for (int u = 0; u < 9; u++) {
+            for (int i = 0; i < 9; i++) {
+                cells[u][i]      = u * 9 + i;
+                cells[9 + u][i]  = i * 9 + u;
+                cells[18 + u][i] = (u / 3 * 3 + i / 3) * 9 + u % 3 * 3 + i % 3;
+            }
+        }
+    }
+} UNITS;
+
+static uint64_t lane_mask(V v) {
+    alignas(64) uint16_t lanes[LaneSolver::LANES];
+    store(lanes, v);
+    uint64_t mask = 0;
+    for (int k = 0; k < LaneSolver::LANES; k++)
+        if (lanes[k]) mask |= 1ULL << k;
+    return mask;
+}
+
+// Returns the lanes that ran into a contradiction: a cell without candidates, a unit without some digit, or two
+// hidden singles in one cell.
+uint64_t LaneSolver::pass() {
+    V broken = zero();
+
+    // naked singles: a cell's only candidate leaves its peers
+    for (int i = 0; i < 81; i++) {
+        V s = singles(load(cells[i]));
+        const unsigned char *peers = Sudoku::peers(i);
+        for (int p = 0; p < 20; p++) store(cells[peers[p]], andnot(s, load(cells[peers[p]])));
+    }
+
+    // hidden singles: a candidate that is in one cell of a unit only is that cell's value
+    for (int u = 0; u < 27; u++) {
+        V once  = zero();
+        V twice = zero();
+        for (int i = 0; i < 9; i++) {
+            V v   = load(cells[UNITS.cells[u][i]]);
+            twice = vor(twice, vand(once, v));
+            once  = vor(once, v);
+        }
+        V only = andnot(twice, once);
+        broken = vor(broken, andnot(once, all()));
+        for (int i = 0; i < 9; i++) {
+            uint16_t *cell = cells[UNITS.cells[u][i]];
+            V v            = load(cell);
+            V hidden       = vand(v, only);
+            broken         = vor(broken, vand(hidden, dec(hidden)));
+            store(cell, vor(hidden, andnot(nonzero(hidden), v)));
+        }
+    }
+
+    // block/line: a candidate that is in one row (column) of a block only leaves the rest of that row (column)
+    for (int b = 0; b < 9; b++) {
+        int br = b / 3 * 3;
+        int bc = b % 3 * 3;
+        V rows[3], cols[3];
+        for (int k = 0; k < 3; k++) rows[k] = cols[k] = zero();
+        for (int i = 0; i < 9; i++) {
+            V v         = load(cells[(br + i / 3) * 9 + bc + i % 3]);
+            rows[i / 3] = vor(rows[i / 3], v);
+            cols[i % 3] = vor(cols[i % 3], v);
+        }
+        for (int k = 0; k < 3; k++) {
+            V row_only = andnot(vor(rows[(k + 1) % 3], rows[(k + 2) % 3]), rows[k]);
+            V col_only = andnot(vor(cols[(k + 1) % 3], cols[(k + 2) % 3]), cols[k]);
+            for (int j = 0; j < 9; j++) {
+                if (j / 3 == b % 3) continue;
+                uint16_t *cell = cells[(br + k) * 9 + j];
+                store(cell, andnot(row_only, load(cell)));
+            }
+            for (int j = 0; j < 9; j++) {
+                if (j / 3 == b / 3) continue;
+                uint16_t *cell = cells[j * 9 + bc + k];
+                store(cell, andnot(col_only, load(cell)));
+            }
+        }
+    }
+
+    for (int i = 0; i < 81; i++) broken = vor(broken, andnot(nonzero(load(cells[i])), all()));
+    return lane_mask(broken);
+}
+
+uint64_t LaneSolver::changed_lanes() const {
+    V diff = zero();
+    for (int i = 0; i < 81; i++) diff = vor(diff, vxor(load(cells[i]), load(prev[i])));
+    return lane_mask(diff);
+}
+
+void LaneSolver::run(const std::function<bool(Sudoku &)> &next, const std::function<void(size_t, Sudoku &)> &done) {
+    // the input puzzle of each lane, for its original marks and to finish it with
+    std::vector<Sudoku> puzzles(LANES, Sudoku(""));
+    size_t index[LANES];
+    size_t taken  = 0;
+    uint64_t busy = 0;
+
+    Sudoku puzzle("");
+    auto fill = [&](int k) {
+        if (!next(puzzle)) {
+            for (int i = 0; i < 81; i++) cells[i][k] = ALL;  // stays unchanged, so never finishes again
+            return;
+        }
+        puzzles[k] = puzzle;
+        index[k]   = taken++;
+        busy |= 1ULL << k;
+        for (int i = 0; i < 81; i++) cells[i][k] = puzzle.candidates(i / 9, i % 9);
+    };
+
+    for (int k = 0; k < LANES; k++) fill(k);
+
+    unsigned short candidates[81];
+    while (busy) {
+        memcpy(prev, cells, sizeof(cells));
+        uint64_t broken = busy & pass();
+
+        uint64_t stuck = busy & ~changed_lanes();
+        for (int k = 0; k < LANES; k++) {
+            if (!((stuck | broken) & (1ULL << k))) continue;
+
+            // the passes are not the scalar techniques in the scalar order, and on a puzzle without a solution where
+            // they stop depends on the order; start over from the givens
+            if (broken & (1ULL << k)) {
+                Sudoku &result = puzzles[k];
+                result.calcFixpoint(result);
+                done(index[k], result);
+
+                busy &= ~(1ULL << k);
+                fill(k);
+                continue;
+            }
+
+            bool solved = true;
+            for (int i = 0; i < 81; i++) {
+                candidates[i] = cells[i][k];
+                solved        = solved && Cell::cntCandidates(candidates[i]) == 1;
+            }
+
+            // a solved grid the naked singles pass left alone is a fixpoint of every technique
+            Sudoku &result = puzzles[k];
+            if (solved) {
+                result.loadFixpoint(candidates);
+            } else {
+                result.loadCandidates(candidates);
+                result.calcFixpoint(result);
+            }
+            done(index[k], result);
+
+            busy &= ~(1ULL << k);
+            fill(k);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "sudoku.h"
+
+// Solves a stream of puzzles LANES at a time, in structure-of-arrays form: cells[i][k] is cell i of the puzzle in lane
+// k, so one vector instruction works on the same cell of every puzzle. Lanes propagate naked singles, hidden singles
+// and block/line eliminations (calc_only_one_candidate_in_cell, calc_only_one_candidate_in_row_or_column_or_block and
+// calc_block_candidates_in_same_row_or_column) together; a lane whose puzzle stops changing is finished with
+// Sudoku::calcFixpoint and refilled with the next puzzle. A lane that runs into a contradiction is solved again from
+// its givens with calcFixpoint, so results are the same as solving one puzzle at a time.
+//
+// Uses AVX-512BW (32 lanes) or AVX2 (16 lanes) when compiled for them, e.g. with -DSUDOKU_MARCH=native, and plain
+// loops over 16 lanes otherwise.
+class LaneSolver {
+public:
+#if defined(__AVX512BW__)
+    constexpr static int LANES = 32;
+#else
+    constexpr static int LANES = 16;
+#endif
+
+    // Pulls puzzles from `next` until it returns false, and hands each result to `done` with the puzzle's position in
+    // the input. Results come out of order.
+    void run(const std::function<bool(Sudoku &)> &next, const std::function<void(size_t, Sudoku &)> &done);
+
+private:
+    alignas(64) uint16_t cells[81][LANES];
+    alignas(64) uint16_t prev[81][LANES];
+
+    uint64_t pass();
+    uint64_t changed_lanes() const;
+};
+
+#endif  // LANES_H
@@ -1,9 +1,41 @@
+#include <stdio.h>
+#include <string.h>
+#include <memory>
 #include <vector>
 #include "board.h"
+#include "corpus.h"
+#include "editor.h"
+#include "hint.h"
+#include "parallel.h"
 #include "screen.h"
 #include "sudoku.h"
+#include "tile.h"
 
 int main(int argc, char *argv[]) {
+    // --parallel tries the techniques of each step on a thread pool
+    std::unique_ptr<StepPool> pool;
+    if (argc > 1 && strcmp(argv[1], "--parallel") == 0) {
+        pool = std::make_unique<StepPool>();
+        argc--;
+        argv++;
+    }
+    auto calcOneStep = [&](const Sudoku &sudoku, Sudoku &next) {
+        return pool ? pool->calcOneStep(next) : sudoku.calcOneStep(next);
+    };
+
+    if (argc > 1) {
+        CorpusFile corpus(argv[1]);
+        if (!corpus.ok()) {
+            perror(argv[1]);
+            return 1;
+        }
+
+        Screen screen;
+        TileView view(screen, corpus);
+        view.run();
+        return 0;
+    }
+
     Screen screen;
 
     Sudoku sudoku(
@@ -20,25 +52,76 @@ int main(int argc, char *argv[]) {
     Board board(screen);
     board.draw(sudoku);
 
+    HintEngine hints;
+    std::unique_ptr<Editor> editor;
     std::vector<Sudoku> v{sudoku};
     while (true) {
         char ch = (char)getch();
+        screen.clear_line(Board::HEIGHT);
+
+        if (editor) {
+            if (ch == 'e') {
+                editor.reset();
+                board.draw(*v.rbegin());
+                continue;
+            }
+
+            if (ch == 'h') editor->move(0, -1);
+            if (ch == 'j') editor->move(1, 0);
+            if (ch == 'k') editor->move(-1, 0);
+            if (ch == 'l') editor->move(0, 1);
+            bool edited = false;
+            if ('1' <= ch && ch <= '9') edited = editor->set(ch - '0');
+            if (ch == '0' || ch == ' ' || ch == '.') edited = editor->set(0);
+
+            // the edited puzzle starts a new history, from its givens like the built-in one
+            if (edited) {
+                char givens[82];
+                editor->givens(givens);
+                v = {Sudoku(givens)};
+            }
+            board.draw(editor->board(), &editor->boardMarks());
+
+            char line[128];
+            snprintf(line,
+                     sizeof(line),
+                     "edit: hjkl move, 1-9 set, 0 clear, e done; %d conflict(s)",
+                     editor->conflictCnt());
+            screen.draw(Board::HEIGHT, 0, line, COLOR_INDEX_DEFAULT_COLOR);
+            continue;
+        }
 
-        if (ch == 'h' && v.size() > 1) {
+        if (ch == 'e') {
+            editor = std::make_unique<Editor>(*v.begin());
+            board.draw(editor->board(), &editor->boardMarks());
+            screen.draw(Board::HEIGHT, 0, "edit: hjkl move, 1-9 set, 0 clear, e done", COLOR_INDEX_DEFAULT_COLOR);
+        } else if (ch == 'h' && v.size() > 1) {
             v.pop_back();
             board.draw(*v.rbegin());
         } else if (ch == 'l') {
             Sudoku next(*v.rbegin());
-            if (!sudoku.calcOneStep(next)) continue;
+            if (!calcOneStep(sudoku, next)) continue;
             v.emplace_back(std::move(next));
             board.draw(*v.rbegin());
         } else if (ch == 'a') {
             while (true) {
                 Sudoku next(*v.rbegin());
-                if (!sudoku.calcOneStep(next)) break;
+                if (!calcOneStep(sudoku, next)) break;
                 v.emplace_back(std::move(next));
             }
             board.draw(*v.rbegin());
+        } else if (ch == '?') {
+            const Hint &hint = hints.next(*v.rbegin());
+            char line[128];
+            if (hint.found)
+                snprintf(line,
+                         sizeof(line),
+                         "hint: %s, %zu cell(s)",
+                         Sudoku::techniqueName(hint.technique),
+                         hint.eliminations.size());
+            else
+                snprintf(line, sizeof(line), hint.complete ? "hint: none" : "hint: none found in time");
+            screen.draw(Board::HEIGHT, 0, line, COLOR_INDEX_DEFAULT_COLOR);
         }
     }
 
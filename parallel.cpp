@@ -0,0 +1,108 @@
+#include "parallel.h"
+
+#include <algorithm>
+
+StepPool::StepPool(int threads) {
+    // more threads than techniques would have nothing to do
+    threads = std::max(0, std::min(threads, TECHNIQUE_CNT - 1));
+    for (int i = 0; i < threads; i++) workers.emplace_back(&StepPool::work, this);
+}
+
+StepPool::~StepPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    for (auto &worker : workers) worker.join();
+}
+
+void StepPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t seen = generation;
+    while (true) {
+        work_cv.wait(lock, [&] { return stopping || seen != generation; });
+        if (stopping) return;
+        seen = generation;
+
+        std::shared_ptr<Step> step = current;
+        while (run_task(*step, lock)) {}
+    }
+}
+
+// Takes the next technique of step and runs it with the lock released; false when there is none left.
+bool StepPool::run_task(Step &step, std::unique_lock<std::mutex> &lock) {
+    if (step.next_task >= TECHNIQUE_CNT) return false;
+
+    int t = step.next_task++;
+    if (t > step.best) {
+        step.state[t] = SKIPPED;
+        return true;
+    }
+
+    lock.unlock();
+    Sudoku &slot = step.slots[t];
+    slot         = step.snapshot;
+    bool hit     = step.snapshot.calcTechnique((Technique)t, slot, &step.cancel[t]);
+    lock.lock();
+
+    // a cancelled technique is after a hit, so its outcome does not matter
+    if (step.cancel[t]) {
+        step.state[t] = SKIPPED;
+    } else if (hit) {
+        step.state[t] = HIT;
+        step.best     = std::min(step.best, t);
+        for (int u = t + 1; u < TECHNIQUE_CNT; u++) step.cancel[u] = true;
+    } else {
+        step.state[t] = MISS;
+    }
+    done_cv.notify_all();
+    return true;
+}
+
+// The result is known once every technique before the first hit has missed. winner is TECHNIQUE_CNT if all missed.
+bool StepPool::decided(const Step &step, int &winner) {
+    for (winner = 0; winner < TECHNIQUE_CNT; winner++) {
+        if (step.state[winner] == PENDING) return false;
+        if (step.state[winner] == HIT) return true;
+    }
+    return true;
+}
+
+bool StepPool::calcOneStep(Sudoku &dst, Technique *technique) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // techniques of the last step still winding down keep using its snapshot and slots; reuse them only when unused
+    if (!current || current.use_count() > 1) current = std::make_shared<Step>();
+    Step &step    = *current;
+    step.snapshot = dst;
+    step.snapshot.clear_reasons();
+    for (int t = 0; t < TECHNIQUE_CNT; t++) {
+        step.state[t]  = PENDING;
+        step.cancel[t] = false;
+    }
+    step.next_task = 0;
+    step.best      = TECHNIQUE_CNT;
+    generation++;
+    work_cv.notify_all();
+
+    int winner;
+    while (!decided(step, winner) && run_task(step, lock)) {}
+    done_cv.wait(lock, [&] { return decided(step, winner); });
+
+    // calc_only_one_candidate_in_cell marks done cells even when it misses, and sequentially it always runs first
+    dst = step.slots[winner < TECHNIQUE_CNT ? winner : 0];
+    if (winner > 0 && winner < TECHNIQUE_CNT) {
+        for (int r = 0; r < 9; r++)
+            for (int c = 0; c < 9; c++)
+                if (step.slots[0].done(r, c)) dst.markDone(r, c);
+    }
+
+    // whatever is still running or pending comes after the winner
+    step.next_task = TECHNIQUE_CNT;
+    for (int t = 0; t < TECHNIQUE_CNT; t++) step.cancel[t] = true;
+
+    if (winner == TECHNIQUE_CNT) return false;
+    if (technique) *technique = (Technique)winner;
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sudoku.h"
+
+// Makes a step like Sudoku::calcOneStep, but tries the techniques at the same time on a small pool of threads, each
+// on its own copy of a read-only snapshot of the board. The lowest-ordered technique that applies wins, so the result
+// is exactly the sequential one (board, done marks and reasons); techniques after it that have not started yet are
+// skipped, and ones already running are cancelled through calcTechnique. A late hit such as calc_isolate3 then costs
+// about as much as itself instead of the sum of every technique before it.
+//
+// Each step has its own snapshot and slots, so a cancelled technique still winding down never holds up the next step.
+// The calling thread takes part, so a pool with 0 threads is the sequential order. Not for use from two threads.
+class StepPool {
+    enum State { PENDING, HIT, MISS, SKIPPED };
+
+    struct Step {
+        Sudoku snapshot;
+        std::vector<Sudoku> slots;
+        State state[TECHNIQUE_CNT];
+        std::atomic<bool> cancel[TECHNIQUE_CNT];
+        int next_task = 0;
+        int best      = TECHNIQUE_CNT;  // lowest technique that applied
+
+        Step() : snapshot(""), slots(TECHNIQUE_CNT, Sudoku("")) {}
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    bool stopping       = false;
+    uint64_t generation = 0;
+    std::shared_ptr<Step> current;  // the latest step; a worker keeps the one it is in alive, which may be older
+
+    void work();
+    bool run_task(Step &step, std::unique_lock<std::mutex> &lock);
+    static bool decided(const Step &step, int &winner);
+
+public:
+    explicit StepPool(int threads = std::thread::hardware_concurrency() - 1);
+    ~StepPool();
+
+    bool calcOneStep(Sudoku &dst, Technique *technique = nullptr);
+};
+
+#endif  // PARALLEL_H
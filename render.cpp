@@ -0,0 +1,148 @@
+#include "render.h"
+
+#include <stdio.h>
+#include <string.h>
+
+struct ColorStyle {
+    const char *ansi;
+    const char *fg;
+    const char *bg;
+};
+
+// Same colors as the pairs Screen::init sets up.
+const static ColorStyle STYLES[COLOR_INDEX_CNT] = {
+    {"0", "#ffffff", nullptr},          // COLOR_INDEX_DEFAULT_COLOR
+    {"0;31", "#ff3333", nullptr},       // COLOR_INDEX_RED
+    {"0;37;44", "#ffffff", "#3333cc"},  // COLOR_INDEX_DEFAULT_HIGHLIGHT
+    {"0;33", "#ffff33", nullptr},       // COLOR_INDEX_YELLOW
+    {"0;37;44", "#ffffff", "#3333cc"},  // COLOR_INDEX_DEFAULT_COLOR_CANDIDATE
+    {"0;31;44", "#ff3333", "#3333cc"},  // COLOR_INDEX_RED_HIGHLIGHT
+    {"0;37;42", "#ffffff", "#33aa33"},  // COLOR_INDEX_DEFAULT_COLOR_TARGET
+    {"0;33;44", "#ffff33", "#3333cc"},  // COLOR_INDEX_YELLOW_HIGHLIGHT
+    {"0;37;41", "#ffffff", "#cc3333"},  // COLOR_INDEX_CONFLICT
+};
+
+const static char *BACKGROUND = "#000000";
+
+inline static int valid_color_index(int ci) { return (0 <= ci && ci < COLOR_INDEX_CNT) ? ci : 0; }
+
+void FrameRenderer::draw(int r, int c, const char *str, int color_index) {
+    if (r < 0 || r >= ROW_CNT || c < 0 || c >= COL_CNT) return;
+
+    strncpy(glyph[r][c], str, sizeof(glyph[r][c]) - 1);
+    colorindex[r][c] = valid_color_index(color_index);
+}
+
+const std::string &AnsiRenderer::frame(const char *title) {
+    out.erase();
+    if (title) out.append(title).append("\n");
+
+    for (int r = 0; r < ROW_CNT; r++) {
+        int ci = 0;
+        for (int c = 0; c < COL_CNT; c++) {
+            if (colorindex[r][c] != ci) {
+                ci = colorindex[r][c];
+                out.append("\x1b[").append(STYLES[ci].ansi).append("m");
+            }
+            out.append(glyph[r][c]);
+        }
+        if (ci != 0) out.append("\x1b[0m");
+        out.append("\n");
+    }
+
+    return out;
+}
+
+const std::string &HtmlRenderer::begin() {
+    out.erase();
+    out.append("<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><style>\n");
+    out.append("body{background:").append(BACKGROUND).append(";color:").append(STYLES[0].fg).append("}\n");
+    out.append("pre{line-height:1.1}\n");
+    for (int ci = 1; ci < COLOR_INDEX_CNT; ci++) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), ".c%d{", ci);
+        out.append(buf).append("color:").append(STYLES[ci].fg);
+        if (STYLES[ci].bg) out.append(";background:").append(STYLES[ci].bg);
+        out.append("}\n");
+    }
+    out.append("</style></head><body>\n");
+    return out;
+}
+
+const std::string &HtmlRenderer::end() {
+    out.erase();
+    out.append("</body></html>\n");
+    return out;
+}
+
+const std::string &HtmlRenderer::frame(const char *title) {
+    out.erase();
+    if (title) out.append("<h3>").append(title).append("</h3>\n");
+
+    out.append("<pre>");
+    for (int r = 0; r < ROW_CNT; r++) {
+        int ci = 0;
+        for (int c = 0; c < COL_CNT; c++) {
+            if (colorindex[r][c] != ci) {
+                if (ci != 0) out.append("</span>");
+                ci = colorindex[r][c];
+                if (ci != 0) out.append("<span class=\"c").append(1, '0' + ci).append("\">");
+            }
+            out.append(glyph[r][c]);
+        }
+        if (ci != 0) out.append("</span>");
+        out.append("\n");
+    }
+    out.append("</pre>\n");
+
+    return out;
+}
+
+const std::string &SvgRenderer::frame(const char *title) {
+    const int CELL_W = 9;
+    const int CELL_H = 16;
+
+    char buf[128];
+    out.erase();
+
+    snprintf(buf,
+             sizeof(buf),
+             "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\">\n",
+             COL_CNT * CELL_W,
+             ROW_CNT * CELL_H);
+    out.append(buf);
+    if (title) out.append("<title>").append(title).append("</title>\n");
+    out.append("<rect width=\"100%\" height=\"100%\" fill=\"").append(BACKGROUND).append("\"/>\n");
+
+    for (int r = 0; r < ROW_CNT; r++) {
+        for (int c = 0; c < COL_CNT; c++) {
+            const char *bg = STYLES[colorindex[r][c]].bg;
+            if (!bg) continue;
+            snprintf(buf,
+                     sizeof(buf),
+                     "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"",
+                     c * CELL_W,
+                     r * CELL_H,
+                     CELL_W,
+                     CELL_H);
+            out.append(buf).append(bg).append("\"/>\n");
+        }
+    }
+
+    out.append("<g font-family=\"monospace\" font-size=\"14\" text-anchor=\"middle\">\n");
+    for (int r = 0; r < ROW_CNT; r++) {
+        for (int c = 0; c < COL_CNT; c++) {
+            if (glyph[r][c][0] == ' ' || glyph[r][c][0] == 0) continue;
+            snprintf(buf,
+                     sizeof(buf),
+                     "<text x=\"%d\" y=\"%d\" fill=\"%s\">",
+                     c * CELL_W + CELL_W / 2,
+                     r * CELL_H + CELL_H * 3 / 4,
+                     STYLES[colorindex[r][c]].fg);
+            out.append(buf).append(glyph[r][c]).append("</text>\n");
+        }
+    }
+    out.append("</g>\n</svg>\n");
+
+    return out;
+}
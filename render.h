@@ -0,0 +1,51 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <string>
+
+#include "board.h"
+#include "canvas.h"
+
+// Headless Canvas: keeps the glyphs and color indexes of one frame in a fixed grid, and turns them into text on
+// request. The grid and the output string are reused from frame to frame, so rendering a long trace allocates only
+// while the output string grows to its largest frame.
+class FrameRenderer : public Canvas {
+public:
+    const static int ROW_CNT = Board::HEIGHT;
+    const static int COL_CNT = Board::WIDTH;
+
+    void draw(int r, int c, const char *str, int color_index) override;
+
+    // Text that goes before the first and after the last frame of a stream; empty if frames stand alone.
+    virtual const std::string &begin() { return out.erase(); }
+    virtual const std::string &end() { return out.erase(); }
+    // Text of the frame drawn since the last call.
+    virtual const std::string &frame(const char *title) = 0;
+
+protected:
+    char glyph[ROW_CNT][COL_CNT][4] = {};  // UTF-8, at most 3 bytes for the box drawing characters
+    int colorindex[ROW_CNT][COL_CNT] = {};
+    std::string out;
+};
+
+// Text with ANSI color escapes, as `less -R` or a terminal would show it.
+class AnsiRenderer : public FrameRenderer {
+public:
+    const std::string &frame(const char *title) override;
+};
+
+// One HTML document with a <pre> per frame.
+class HtmlRenderer : public FrameRenderer {
+public:
+    const std::string &begin() override;
+    const std::string &end() override;
+    const std::string &frame(const char *title) override;
+};
+
+// One standalone SVG document per frame.
+class SvgRenderer : public FrameRenderer {
+public:
+    const std::string &frame(const char *title) override;
+};
+
+#endif  // RENDER_H
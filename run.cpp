@@ -0,0 +1,53 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "corpus.h"
+#include "runner.h"
+
+// Grades a corpus file, or one shard of it, into an NDJSON step trace; run it again after a crash to resume. See
+// ShardRunner for the sharding and the trace format.
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--shard I/N] [--checkpoint-every PUZZLES] --out TRACE CORPUS\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    const char *out = nullptr;
+    const char *in  = nullptr;
+    int shard       = 0;
+    int shards      = 1;
+    long every      = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d/%d", &shard, &shards) != 2) usage(argv[0]);
+        } else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+            every = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out = argv[++i];
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+        } else {
+            in = argv[i];
+        }
+    }
+    if (!out || !in || shards <= 0 || shard < 0 || shard >= shards || every <= 0) usage(argv[0]);
+
+    CorpusFile corpus(in);
+    if (!corpus.ok()) {
+        perror(in);
+        return 1;
+    }
+
+    ShardRunner runner(corpus, out, shard, shards);
+    int err = runner.run(every);
+    if (err) {
+        const char *why = err == ESTALE ? "checkpoint does not match the input, shard or trace" : strerror(err);
+        fprintf(stderr, "%s: %s\n", out, why);
+        return 1;
+    }
+    return 0;
+}
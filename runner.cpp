@@ -0,0 +1,301 @@
+#include "runner.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+void TraceWriter::ensure(size_t n) {
+    if ((size_t)(limit - p) >= n) return;
+    if (block + 1 == BLOCK_CNT) {
+        flush();
+        return;
+    }
+
+    iov[block].iov_base = blocks[block];
+    iov[block].iov_len  = p - blocks[block];
+    block++;
+    p     = blocks[block];
+    limit = blocks[block] + BLOCK_SIZE;
+}
+
+void TraceWriter::put(const char *s) {
+    while (*s) *p++ = *s++;
+}
+
+void TraceWriter::put(uint64_t n) {
+    char digits[20];
+    int len = 0;
+    do {
+        digits[len++] = '0' + n % 10;
+        n /= 10;
+    } while (n);
+    while (len) *p++ = digits[--len];
+}
+
+void TraceWriter::put_cells(const char *name, const unsigned short v[81]) {
+    put(",\"");
+    put(name);
+    put("\":[");
+    bool first = true;
+    for (int i = 0; i < 81; i++) {
+        if (!v[i]) continue;
+        put(first ? "[" : ",[");
+        *p++ = '0' + i / 9;
+        *p++ = ',';
+        *p++ = '0' + i % 9;
+        *p++ = ',';
+        put((uint64_t)v[i]);
+        *p++ = ']';
+        first = false;
+    }
+    *p++ = ']';
+}
+
+void TraceWriter::step(uint64_t offset, int step, Technique technique, const Sudoku &before, const Sudoku &after) {
+    unsigned short changed[81];
+    unsigned short reasons[81] = {};
+    for (int i = 0; i < 81; i++) changed[i] = before.candidates(i / 9, i % 9) & ~after.candidates(i / 9, i % 9);
+    after.forEachReason([&](RC rc, unsigned short v) { reasons[rc.r * 9 + rc.c] = v; });
+
+    ensure(RECORD_MAX);
+    put("{\"offset\":");
+    put(offset);
+    put(",\"step\":");
+    put((uint64_t)step);
+    put(",\"technique\":\"");
+    put(Sudoku::techniqueName(technique));
+    put("\"");
+    put_cells("changed", changed);
+    put_cells("reasons", reasons);
+    put("}\n");
+}
+
+void TraceWriter::end(uint64_t offset, int steps, bool solved) {
+    ensure(RECORD_MAX);
+    put("{\"offset\":");
+    put(offset);
+    put(",\"steps\":");
+    put((uint64_t)steps);
+    put(solved ? ",\"solved\":true}\n" : ",\"solved\":false}\n");
+}
+
+bool TraceWriter::flush() {
+    iov[block].iov_base = blocks[block];
+    iov[block].iov_len  = p - blocks[block];
+    int cnt             = block + 1;
+
+    // writev may write less than asked; carry on from where it stopped
+    struct iovec *v = iov;
+    while (cnt > 0 && !error) {
+        ssize_t n = writev(fd, v, cnt);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            error = true;
+            break;
+        }
+        while (cnt > 0 && (size_t)n >= v->iov_len) {
+            n -= v->iov_len;
+            v++;
+            cnt--;
+        }
+        if (cnt > 0) {
+            v->iov_base = (char *)v->iov_base + n;
+            v->iov_len -= n;
+        }
+    }
+
+    block = 0;
+    p     = blocks[0];
+    limit = blocks[0] + BLOCK_SIZE;
+    return !error;
+}
+
+// A checkpoint is one line: the input it is for (size, fingerprint, inode and mtime), the shard, the offset of the
+// next puzzle, and the trace length up to there.
+struct Checkpoint {
+    uint64_t input_size;
+    uint64_t input_hash;
+    uint64_t input_inode;
+    uint64_t input_mtime;
+    int shard;
+    int shards;
+    uint64_t next;
+    uint64_t out_size;
+};
+
+// FNV-1a over the first and the last 4KB of the input. Cheap even for a huge corpus, but it only sees edits near either
+// end; the inode and mtime are what catch the rest.
+static uint64_t fingerprint(const char *data, uint64_t size) {
+    const uint64_t SPAN = 4096;
+    uint64_t hash       = 14695981039346656037ULL;
+    auto mix            = [&](uint64_t from, uint64_t to) {
+        for (uint64_t i = from; i < to; i++) hash = (hash ^ (unsigned char)data[i]) * 1099511628211ULL;
+    };
+    mix(0, std::min(size, SPAN));
+    mix(size - std::min(size, SPAN), size);
+    return hash;
+}
+
+// Returns 0, ENOENT when there is no checkpoint, or ESTALE when there is one that does not parse.
+static int read_checkpoint(const std::string &path, Checkpoint &ckpt) {
+    FILE *f = fopen(path.c_str(), "r");
+    if (!f) return errno;
+    unsigned long long input_size, input_hash, input_inode, input_mtime, next, out_size;
+    int n = fscanf(f,
+                   "%llu %llx %llu %llu %d %d %llu %llu",
+                   &input_size,
+                   &input_hash,
+                   &input_inode,
+                   &input_mtime,
+                   &ckpt.shard,
+                   &ckpt.shards,
+                   &next,
+                   &out_size);
+    fclose(f);
+
+    ckpt.input_size  = input_size;
+    ckpt.input_hash  = input_hash;
+    ckpt.input_inode = input_inode;
+    ckpt.input_mtime = input_mtime;
+    ckpt.next        = next;
+    ckpt.out_size    = out_size;
+    return n == 8 ? 0 : ESTALE;
+}
+
+// Atomic: a crash leaves either the old or the new checkpoint, never half of one.
+static int write_checkpoint(const std::string &path, const Checkpoint &ckpt) {
+    std::string tmp = path + ".tmp";
+    FILE *f         = fopen(tmp.c_str(), "w");
+    if (!f) return errno;
+    fprintf(f,
+            "%llu %016llx %llu %llu %d %d %llu %llu\n",
+            (unsigned long long)ckpt.input_size,
+            (unsigned long long)ckpt.input_hash,
+            (unsigned long long)ckpt.input_inode,
+            (unsigned long long)ckpt.input_mtime,
+            ckpt.shard,
+            ckpt.shards,
+            (unsigned long long)ckpt.next,
+            (unsigned long long)ckpt.out_size);
+    if (fflush(f) != 0 || fsync(fileno(f)) != 0) {
+        int err = errno;
+        fclose(f);
+        return err;
+    }
+    fclose(f);
+    if (rename(tmp.c_str(), path.c_str()) != 0) return errno;
+
+    // the rename itself is only durable once the directory is
+    size_t slash    = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd          = open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return errno;
+    int err = fsync(fd) == 0 ? 0 : errno;
+    close(fd);
+    return err;
+}
+
+int ShardRunner::run(size_t every) {
+    const char *data = corpus.bytes();
+    uint64_t size    = corpus.byteSize();
+    uint64_t begin   = size * shard / shards;
+    uint64_t stop    = size * (shard + 1) / shards;
+    // a line that starts in the previous shard is that shard's
+    while (begin > 0 && begin < size && data[begin - 1] != '\n') begin++;
+
+    std::string ckpt_path = std::string(out) + ".ckpt";
+    Checkpoint ckpt{
+        size, fingerprint(data, size), corpus.fileInode(), corpus.fileMtimeNs(), shard, shards, begin, 0};
+    Checkpoint last;
+    int err = read_checkpoint(ckpt_path, last);
+    if (err == 0) {
+        if (last.input_size != size || last.input_hash != ckpt.input_hash || last.input_inode != ckpt.input_inode ||
+            last.input_mtime != ckpt.input_mtime || last.shard != shard || last.shards != shards)
+            return ESTALE;
+        // the next puzzle starts a line (or it is the end), unless the file changed under the same inode and mtime
+        if (last.next < begin || last.next > size ||
+            (last.next != begin && last.next != size && data[last.next - 1] != '\n'))
+            return ESTALE;
+        ckpt = last;
+    } else if (err != ENOENT) {
+        return err;
+    }
+
+    int fd = open(out, O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) return errno;
+    // drop whatever was written after the checkpoint; a trace shorter than that is not the one checkpointed
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        err = errno;
+        close(fd);
+        return err;
+    }
+    if ((uint64_t)st.st_size < ckpt.out_size) {
+        close(fd);
+        return ESTALE;
+    }
+    if (ftruncate(fd, ckpt.out_size) != 0 || lseek(fd, ckpt.out_size, SEEK_SET) < 0) {
+        err = errno;
+        close(fd);
+        return err;
+    }
+
+    auto writer     = std::make_unique<TraceWriter>(fd);  // 1MB of blocks, too big for the stack
+    auto checkpoint = [&](uint64_t next) {
+        if (!writer->flush() || fsync(fd) != 0) return errno ? errno : EIO;
+        if (fstat(fd, &st) != 0) return errno;
+        ckpt.next     = next;
+        ckpt.out_size = st.st_size;
+        return write_checkpoint(ckpt_path, ckpt);
+    };
+
+    char line[82];
+    size_t since = 0;
+    uint64_t at  = ckpt.next;
+    while (at < stop && at < size) {
+        const char *nl = (const char *)memchr(data + at, '\n', size - at);
+        uint64_t next  = nl ? (nl - data) + 1 : size;
+        if (data[at] == '\n' || data[at] == '\r' || data[at] == '#') {
+            at = next;
+            continue;
+        }
+
+        int len = 0;
+        for (; len < 81 && at + len < size && data[at + len] != '\n'; len++) line[len] = data[at + len];
+        line[len] = 0;
+
+        Sudoku sudoku(line);
+        Sudoku before(sudoku);
+        Sudoku after(sudoku);
+        Technique technique;
+        int steps = 0;
+        while (sudoku.calcOneStep(after, &technique)) {
+            writer->step(at, ++steps, technique, before, after);
+            before = after;
+        }
+        bool solved = true;
+        for (int i = 0; i < 81; i++) solved = solved && after.onlyOneCandidate(i / 9, i % 9);
+        writer->end(at, steps, solved);
+
+        at = next;
+        if (++since == every) {
+            since = 0;
+            err   = checkpoint(at);
+            if (err) {
+                close(fd);
+                return err;
+            }
+        }
+    }
+
+    err = checkpoint(std::max(at, stop));
+    close(fd);
+    return err;
+}
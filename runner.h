@@ -0,0 +1,62 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include "corpus.h"
+#include "sudoku.h"
+
+// Writes NDJSON to a file descriptor without allocating: records are formatted straight into a fixed set of blocks,
+// and full blocks go out together with one writev.
+class TraceWriter {
+    constexpr static int BLOCK_CNT  = 16;
+    constexpr static int BLOCK_SIZE = 64 * 1024;
+    constexpr static int RECORD_MAX = 8 * 1024;  // more than the longest record, 81 changed and 81 reason cells
+
+    const int fd;
+    char blocks[BLOCK_CNT][BLOCK_SIZE];
+    struct iovec iov[BLOCK_CNT];
+    int block   = 0;
+    char *p     = blocks[0];
+    char *limit = blocks[0] + BLOCK_SIZE;
+    bool error  = false;
+
+    void ensure(size_t n);
+    void put(const char *s);
+    void put(uint64_t n);
+    void put_cells(const char *name, const unsigned short v[81]);
+
+public:
+    explicit TraceWriter(int fd_) : fd(fd_) {}
+
+    // {"offset":O,"step":S,"technique":"...","changed":[[r,c,lost],...],"reasons":[[r,c,candidates],...]}
+    void step(uint64_t offset, int step, Technique technique, const Sudoku &before, const Sudoku &after);
+    // {"offset":O,"steps":S,"solved":true|false}
+    void end(uint64_t offset, int steps, bool solved);
+
+    // Writes out everything formatted so far; false if any write failed.
+    bool flush();
+};
+
+// Steps every puzzle of one shard of a corpus file, streaming its trace to `out` and checkpointing to `out`.ckpt, so
+// that a run that died resumes where its last checkpoint left off, with the trace truncated back to match.
+//
+// Shard i of n is the byte range [size * i / n, size * (i + 1) / n) of the file; a puzzle belongs to the shard its line
+// starts in. Records name puzzles by the byte offset of their line, which is the same whatever the sharding.
+class ShardRunner {
+    CorpusFile &corpus;
+    const char *out;
+    int shard;
+    int shards;
+
+public:
+    ShardRunner(CorpusFile &corpus_, const char *out_, int shard_, int shards_)
+        : corpus(corpus_), out(out_), shard(shard_), shards(shards_) {}
+
+    // Checkpoints every `every` puzzles. Returns 0 on success, or an errno.
+    int run(size_t every);
+};
+
+#endif  // RUNNER_H
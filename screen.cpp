@@ -18,6 +18,7 @@ void Screen::init() {
 
     init_pair(COLOR_INDEX_DEFAULT_COLOR_CANDIDATE, COLOR_WHITE, BG_COLOR_CANDIDATE);
     init_pair(COLOR_INDEX_DEFAULT_COLOR_TARGET, COLOR_WHITE, BG_COLOR_TARGET);
+    init_pair(COLOR_INDEX_CONFLICT, COLOR_WHITE, BG_COLOR_CONFLICT);
 }
 
 void Screen::destroy() { endwin(); }
@@ -58,4 +59,8 @@ void Screen::clear_screen() {
     perf_cache.clearCache();
 }
 
-int Screen::width() { return COLS; }
\ No newline at end of file
+int Screen::width() { return COLS; }
+
+int Screen::height() { return LINES; }
+
+void Screen::set_input_timeout(int ms) { timeout(ms); }
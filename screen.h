@@ -3,19 +3,13 @@
 
 #include <ncurses.h>
 
+#include "canvas.h"
+
 #define BG_COLOR_DEFAULT COLOR_BLACK
 #define BG_COLOR_SELECTED COLOR_YELLOW
 #define BG_COLOR_CANDIDATE COLOR_BLUE
 #define BG_COLOR_TARGET COLOR_GREEN
-
-#define COLOR_INDEX_DEFAULT_COLOR 0
-#define COLOR_INDEX_RED 1
-#define COLOR_INDEX_DEFAULT_HIGHLIGHT 2
-#define COLOR_INDEX_YELLOW 3
-#define COLOR_INDEX_DEFAULT_COLOR_CANDIDATE 4
-#define COLOR_INDEX_RED_HIGHLIGHT 5
-#define COLOR_INDEX_DEFAULT_COLOR_TARGET 6
-#define COLOR_INDEX_YELLOW_HIGHLIGHT 7
+#define BG_COLOR_CONFLICT COLOR_RED
 
 #define NO_SCREEN_PERF_CACHE
 class ScreenPerfCache {
@@ -75,7 +69,7 @@ public:
     }
 };
 
-class Screen {
+class Screen : public Canvas {
     ScreenPerfCache perf_cache;
 
 public:
@@ -84,11 +78,13 @@ public:
 
     void init();
     void destroy();
-    void draw(int r, int c, const char *str, int color_index);
+    void draw(int r, int c, const char *str, int color_index) override;
     int get_color_index(bool is_red, int bg_color);
     void clear_line(int r);
     void clear_screen();
     int width();
+    int height();
+    void set_input_timeout(int ms);
 };
 
 #endif  // SCREEN_H
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "sudoku.h"
 
+#include "transposition.h"
+
 #include <algorithm>
 #include <memory>
 #include <utility>
@@ -123,7 +125,7 @@ bool Sudoku::calc_only_one_candidate_in_cell(Sudoku &dst) const {
             if (!dst.cellref(sibling).intersect_c(cell)) continue;
 
             anychange = true;
-            dst.cellref(sibling).exclude_c(cell);
+            dst.exclude_c(sibling, cell);
         }
 
         cell.markDone();
@@ -158,7 +160,7 @@ bool Sudoku::calc_only_one_candidate_in_row_or_column_or_block(Sudoku &dst) cons
             }
 
             if (cnt == 1 && !dst.cellref(lastrc).onlyOneCandidate()) {
-                dst.cellref(lastrc).includeOnly_n(n);
+                dst.includeOnly_n(lastrc, n);
                 dst.addreason_n(lastrc, n);
                 return true;
             }
@@ -188,7 +190,7 @@ bool Sudoku::calc_block_candidates_in_same_row_or_column(Sudoku &dst) const {
                 while (rowiter.hasNext()) {
                     RC rcrc = rowiter.next();
                     if (rc2b(rcrc) != b && dst.cellref(rcrc).intersect_n(n)) {
-                        dst.cellref(rcrc).exclude_n(n);
+                        dst.exclude_n(rcrc, n);
                         anychange = true;
                     }
                 }
@@ -205,7 +207,7 @@ bool Sudoku::calc_block_candidates_in_same_row_or_column(Sudoku &dst) const {
                 while (coliter.hasNext()) {
                     RC rcrc = coliter.next();
                     if (rc2b(rcrc) != b && dst.cellref(rcrc).intersect_n(n)) {
-                        dst.cellref(rcrc).exclude_n(n);
+                        dst.exclude_n(rcrc, n);
                         anychange = true;
                     }
                 }
@@ -240,7 +242,7 @@ bool Sudoku::calc_row_candidates_in_same_block(Sudoku &dst) const {
                 while (blockiter.hasNext()) {
                     RC rcrc = blockiter.next();
                     if (rcrc.r != r && dst.cellref(rcrc).intersect_n(n)) {
-                        dst.cellref(rcrc).exclude_n(n);
+                        dst.exclude_n(rcrc, n);
                         for (auto it = rcs.begin(); it != rcs.end(); it++) dst.addreason_n(*it, n);
                         return true;
                     }
@@ -272,7 +274,7 @@ bool Sudoku::calc_column_candidates_in_same_block(Sudoku &dst) const {
                 while (blockiter.hasNext()) {
                     RC rcrc = blockiter.next();
                     if (rcrc.c != c && dst.cellref(rcrc).intersect_n(n)) {
-                        dst.cellref(rcrc).exclude_n(n);
+                        dst.exclude_n(rcrc, n);
                         for (auto it = rcs.begin(); it != rcs.end(); it++) dst.addreason_n(*it, n);
                         return true;
                     }
@@ -283,7 +285,7 @@ bool Sudoku::calc_column_candidates_in_same_block(Sudoku &dst) const {
     return false;
 }
 
-bool Sudoku::calc_isolate2(Sudoku &dst) const {
+bool Sudoku::calc_isolate2(Sudoku &dst, const std::atomic<bool> *cancel) const {
     IterIter iteriter;
     IterIter iteriter2;
     IterIter iteriter3;
@@ -293,6 +295,7 @@ bool Sudoku::calc_isolate2(Sudoku &dst) const {
         auto iter3 = iteriter3.next();
 
         while (iter->hasNext()) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) return false;
             RC rc = iter->next();
 
             unsigned short candidates1 = dst.cellref(rc).candidates();
@@ -312,7 +315,7 @@ bool Sudoku::calc_isolate2(Sudoku &dst) const {
                     if (RC::cmp(rc, rc3) >= 0) continue;
                     if (RC::cmp(rc2, rc3) >= 0) continue;
                     if (dst.cellref(rc3).intersect_v(candidates2)) {
-                        dst.cellref(rc3).exclude_v(candidates2);
+                        dst.exclude_v(rc3, candidates2);
                         dst.addreason_v(rc, candidates2);
                         dst.addreason_v(rc2, candidates2);
                         return true;
@@ -325,7 +328,7 @@ bool Sudoku::calc_isolate2(Sudoku &dst) const {
     return false;
 }
 
-bool Sudoku::calc_isolate3(Sudoku &dst) const {
+bool Sudoku::calc_isolate3(Sudoku &dst, const std::atomic<bool> *cancel) const {
     IterIter iteriter;
     IterIter iteriter2;
     IterIter iteriter3;
@@ -337,6 +340,7 @@ bool Sudoku::calc_isolate3(Sudoku &dst) const {
         auto iter4 = iteriter4.next();
 
         while (iter->hasNext()) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) return false;
             RC rc = iter->next();
 
             unsigned short candidates1 = dst.cellref(rc).candidates();
@@ -369,7 +373,7 @@ bool Sudoku::calc_isolate3(Sudoku &dst) const {
                         if (RC::cmp(rc3, rc4) >= 0) continue;
                         if (dst.cellref(rc4).onlyOneCandidate()) continue;
                         if (dst.cellref(rc4).intersect_v(candidates3)) {
-                            dst.cellref(rc4).exclude_v(candidates3);
+                            dst.exclude_v(rc4, candidates3);
                             dst.addreason_v(rc, candidates1);
                             dst.addreason_v(rc2, candidates2);
                             dst.addreason_v(rc3, candidates3);
@@ -384,22 +388,110 @@ bool Sudoku::calc_isolate3(Sudoku &dst) const {
     return false;
 }
 
-bool Sudoku::calcOneStep(Sudoku &dst) const {
+const char *Sudoku::techniqueName(Technique technique) {
+    switch (technique) {
+        case TECHNIQUE_ONLY_ONE_CANDIDATE_IN_CELL: return "only_one_candidate_in_cell";
+        case TECHNIQUE_ONLY_ONE_CANDIDATE_IN_ROW_OR_COLUMN_OR_BLOCK:
+            return "only_one_candidate_in_row_or_column_or_block";
+        case TECHNIQUE_BLOCK_CANDIDATES_IN_SAME_ROW_OR_COLUMN: return "block_candidates_in_same_row_or_column";
+        case TECHNIQUE_ROW_CANDIDATES_IN_SAME_BLOCK: return "row_candidates_in_same_block";
+        case TECHNIQUE_COLUMN_CANDIDATES_IN_SAME_BLOCK: return "column_candidates_in_same_block";
+        case TECHNIQUE_ISOLATE2: return "isolate2";
+        case TECHNIQUE_ISOLATE3: return "isolate3";
+        default: return "unknown";
+    }
+}
+
+bool Sudoku::calcTechnique(Technique technique, Sudoku &dst, const std::atomic<bool> *cancel) const {
+    switch (technique) {
+        case TECHNIQUE_ONLY_ONE_CANDIDATE_IN_CELL: return calc_only_one_candidate_in_cell(dst);
+        case TECHNIQUE_ONLY_ONE_CANDIDATE_IN_ROW_OR_COLUMN_OR_BLOCK:
+            return calc_only_one_candidate_in_row_or_column_or_block(dst);
+        case TECHNIQUE_BLOCK_CANDIDATES_IN_SAME_ROW_OR_COLUMN: return calc_block_candidates_in_same_row_or_column(dst);
+        case TECHNIQUE_ROW_CANDIDATES_IN_SAME_BLOCK: return calc_row_candidates_in_same_block(dst);
+        case TECHNIQUE_COLUMN_CANDIDATES_IN_SAME_BLOCK: return calc_column_candidates_in_same_block(dst);
+        case TECHNIQUE_ISOLATE2: return calc_isolate2(dst, cancel);
+        case TECHNIQUE_ISOLATE3: return calc_isolate3(dst, cancel);
+        default: return false;
+    }
+}
+
+bool Sudoku::calcOneStep(Sudoku &dst, Technique *technique) const {
     dst.clear_reasons();
 
-    if (calc_only_one_candidate_in_cell(dst)) return true;
+    for (int t = 0; t < TECHNIQUE_CNT; t++) {
+        if (calcTechnique((Technique)t, dst)) {
+            if (technique) *technique = (Technique)t;
+            return true;
+        }
+    }
 
-    if (calc_only_one_candidate_in_row_or_column_or_block(dst)) return true;
+    return false;
+}
 
-    if (calc_block_candidates_in_same_row_or_column(dst)) return true;
+const unsigned char *Sudoku::peers(int idx) {
+    static unsigned char table[81][20];
+    static bool ready = [] {
+        for (int i = 0; i < 81; i++) {
+            int n = 0;
+            SiblingIter siblings({i / 9, i % 9});
+            while (siblings.hasNext()) {
+                RC rc = siblings.next();
+                // the block repeats the row and column neighbours that are inside it
+                if (std::find(table[i], table[i] + n, rc.r * 9 + rc.c) == table[i] + n) table[i][n++] = rc.r * 9 + rc.c;
+            }
+        }
+        return true;
+    }();
+    (void)ready;
+    return table[idx];
+}
 
-    if (calc_row_candidates_in_same_block(dst)) return true;
+void Sudoku::loadCandidates(const unsigned short candidates[81]) {
+    for (int i = 0; i < 81; i++) cells[i / 9][i % 9].setCandidates(candidates[i]);
+    clear_reasons();
+    rehash();
+}
 
-    if (calc_column_candidates_in_same_block(dst)) return true;
+void Sudoku::loadFixpoint(const unsigned short candidates[81]) {
+    loadCandidates(candidates);
+    // a fixpoint has been through calc_only_one_candidate_in_cell, which marks every single done
+    for (int i = 0; i < 81; i++)
+        if (cells[i / 9][i % 9].onlyOneCandidate()) cells[i / 9][i % 9].markDone();
+}
 
-    if (calc_isolate2(dst)) return true;
+void Sudoku::saveCandidates(unsigned short candidates[81]) const {
+    for (int i = 0; i < 81; i++) candidates[i] = cells[i / 9][i % 9].candidates();
+}
 
-    if (calc_isolate3(dst)) return true;
+void Sudoku::rehash() {
+    zobrist = 0;
+    for (int r = 0; r < 9; r++)
+        for (int c = 0; c < 9; c++) toggle_hash({r, c}, cells[r][c].candidates());
+}
 
-    return false;
-}
\ No newline at end of file
+bool Sudoku::calcFixpoint(Sudoku &dst, TranspositionTable *table) const {
+    std::vector<uint64_t> path;
+    unsigned short fixpoint[81];
+    bool anychange = false;
+
+    while (true) {
+        if (table && table->probe(dst.zobrist, fixpoint)) {
+            uint64_t before = dst.zobrist;
+            dst.loadFixpoint(fixpoint);
+            anychange = anychange || dst.zobrist != before;
+            break;
+        }
+
+        if (table) path.push_back(dst.zobrist);
+        if (!calcOneStep(dst)) break;
+        anychange = true;
+    }
+
+    if (table) {
+        dst.saveCandidates(fixpoint);
+        for (uint64_t h : path) table->store(h, fixpoint);
+    }
+
+    return anychange;
+}
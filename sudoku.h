@@ -1,10 +1,16 @@
 #ifndef SUDOKU_H
 #define SUDOKU_H
 
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
 
+class TranspositionTable;
+
 struct RC {
     int r;
     int c;
@@ -32,6 +38,7 @@ public:
 
     inline bool original() const { return (v & ORIGINAL_MASK) == ORIGINAL_MASK; }
     inline void markOriginal() { v |= ORIGINAL_MASK; }
+    inline void clearMarks() { v &= V_MASK; }
 
     inline unsigned short candidates() const { return v & V_MASK; }
 
@@ -51,14 +58,69 @@ public:
     inline void exclude_v(int vv) { v &= ~vv; }
     inline void exclude_c(const Cell &c) { v &= ~c.candidates(); }
     inline void includeOnly_n(int n) { v = n2v(n); }
+    inline void setCandidates(unsigned short vv) { v = (v & ~V_MASK) | (vv & V_MASK); }
+};
+
+// Zobrist keys over the 81x9 candidate bits: a candidate state hashes to the xor of the keys of the candidates it still
+// has. Generated at compile time with splitmix64, so hashes are stable across runs and processes.
+struct ZobristKeys {
+    uint64_t keys[81][9];
+
+    constexpr ZobristKeys() : keys() {
+        uint64_t seed = 0x5eed5eed5eed5eedULL;
+        for (int i = 0; i < 81; i++) {
+            for (int n = 0; n < 9; n++) {
+                seed += 0x9e3779b97f4a7c15ULL;
+                uint64_t z = seed;
+                z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z          = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                keys[i][n] = z ^ (z >> 31);
+            }
+        }
+    }
+};
+
+inline constexpr ZobristKeys ZOBRIST{};
+
+// The techniques calcOneStep tries, easiest first.
+enum Technique {
+    TECHNIQUE_ONLY_ONE_CANDIDATE_IN_CELL,
+    TECHNIQUE_ONLY_ONE_CANDIDATE_IN_ROW_OR_COLUMN_OR_BLOCK,
+    TECHNIQUE_BLOCK_CANDIDATES_IN_SAME_ROW_OR_COLUMN,
+    TECHNIQUE_ROW_CANDIDATES_IN_SAME_BLOCK,
+    TECHNIQUE_COLUMN_CANDIDATES_IN_SAME_BLOCK,
+    TECHNIQUE_ISOLATE2,
+    TECHNIQUE_ISOLATE3,
+    TECHNIQUE_CNT,
 };
 
 class Sudoku {
     Cell cells[9][9];
     std::map<RC, int, RCCmp> reasons;
 
+    uint64_t zobrist = 0;
+
     inline Cell &cellref(const RC &rc) { return cells[rc.r][rc.c]; }
 
+    // Every candidate change goes through these so that `zobrist` stays in sync with `cells`.
+    inline void toggle_hash(RC rc, unsigned short changed) {
+        for (int n = 0; changed; n++, changed >>= 1)
+            if (changed & 1) zobrist ^= ZOBRIST.keys[rc.r * 9 + rc.c][n];
+    }
+    inline void exclude_n(RC rc, int n) { exclude_v(rc, Cell::n2v(n)); }
+    inline void exclude_v(RC rc, unsigned short v) {
+        Cell &cell = cellref(rc);
+        toggle_hash(rc, cell.candidates() & v);
+        cell.exclude_v(v);
+    }
+    inline void exclude_c(RC rc, const Cell &c) { exclude_v(rc, c.candidates()); }
+    inline void includeOnly_n(RC rc, int n) {
+        Cell &cell = cellref(rc);
+        toggle_hash(rc, cell.candidates() & ~Cell::n2v(n));
+        cell.includeOnly_n(n);
+    }
+    void rehash();
+
     bool calc_only_one_candidate_in_cell(Sudoku &dst) const;
     bool calc_only_one_candidate_in_row_or_column_or_block(Sudoku &dst) const;
 
@@ -66,16 +128,19 @@ class Sudoku {
     bool calc_row_candidates_in_same_block(Sudoku &dst) const;
     bool calc_column_candidates_in_same_block(Sudoku &dst) const;
 
-    bool calc_isolate2(Sudoku &dst) const;
-    bool calc_isolate3(Sudoku &dst) const;
+    // These two are by far the slowest; they give up, returning false, once *cancel is set.
+    bool calc_isolate2(Sudoku &dst, const std::atomic<bool> *cancel) const;
+    bool calc_isolate3(Sudoku &dst, const std::atomic<bool> *cancel) const;
 
+public:
     inline void clear_reasons() { reasons.clear(); }
 
-public:
     inline Sudoku(const Sudoku &src) {
         memcpy(&this->cells[0][0], &src.cells[0][0], sizeof(Cell) * 81);
         reasons = src.reasons;
+        zobrist = src.zobrist;
     }
+    Sudoku &operator=(const Sudoku &) = default;
 
     inline Sudoku(const char *str) {
         int len = strlen(str);
@@ -86,11 +151,33 @@ public:
             }
 
         clear_reasons();
+        rehash();
     }
 
     inline bool possible(int r, int c, int n) const { return cells[r][c].intersect_n(n); }
     inline bool onlyOneCandidate(int r, int c) const { return cells[r][c].onlyOneCandidate(); }
     inline bool original(int r, int c) const { return cells[r][c].original(); }
+    inline unsigned short candidates(int r, int c) const { return cells[r][c].candidates(); }
+    inline bool done(int r, int c) const { return cells[r][c].done(); }
+    inline void markDone(int r, int c) { cells[r][c].markDone(); }
+    // Replaces a cell outright, dropping its done mark; for editing a puzzle rather than solving it.
+    inline void setCell(RC rc, unsigned short candidates, bool original) {
+        Cell &cell = cellref(rc);
+        toggle_hash(rc, cell.candidates() ^ candidates);
+        cell.clearMarks();
+        cell.setCandidates(candidates);
+        if (original) cell.markOriginal();
+    }
+    inline uint64_t hash() const { return zobrist; }
+
+    // Candidates of all cells in row order. Loading keeps the original/done marks and drops the reasons.
+    void loadCandidates(const unsigned short candidates[81]);
+    // Same, for candidates known to be a calcFixpoint result.
+    void loadFixpoint(const unsigned short candidates[81]);
+    void saveCandidates(unsigned short candidates[81]) const;
+
+    // The 20 cells (as r * 9 + c) sharing a row, column or block with cell idx, the same cells SiblingIter visits.
+    static const unsigned char *peers(int idx);
 
     inline void addreason_n(RC rc, int n) { addreason_v(rc, Cell::n2v(n)); }
     inline void addreason_v(RC rc, unsigned short v) {
@@ -110,7 +197,20 @@ public:
         return (iter != reasons.end()) && (iter->second & Cell::n2v(n)) != 0;
     }
 
-    bool calcOneStep(Sudoku &dst) const;
+    template <typename F>
+    void forEachReason(F f) const {
+        for (auto &reason : reasons) f(reason.first, (unsigned short)reason.second);
+    }
+
+    static const char *techniqueName(Technique technique);
+    // One technique on its own; unlike calcOneStep it leaves the reasons already in dst. Setting *cancel from another
+    // thread may stop it early with false and dst unchanged.
+    bool calcTechnique(Technique technique, Sudoku &dst, const std::atomic<bool> *cancel = nullptr) const;
+    bool calcOneStep(Sudoku &dst, Technique *technique = nullptr) const;
+
+    // Runs calcOneStep until nothing changes. With a table, every state passed on the way is remembered as leading to
+    // the resulting fixpoint, and a state already in the table jumps straight to its fixpoint.
+    bool calcFixpoint(Sudoku &dst, TranspositionTable *table = nullptr) const;
 };
 
 #endif  // SUDOKU_H
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "tile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "board.h"
+
+TraceCache::TraceCache() : worker(&TraceCache::work, this) {}
+
+TraceCache::~TraceCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    worker.join();
+}
+
+void TraceCache::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        // one step for each unfinished trace in turn, so that all boards on screen progress together
+        bool anywork = false;
+        for (auto it = traces.begin(); it != traces.end() && !stopping;) {
+            size_t puzzle = it->first;
+            Trace &trace  = it->second;
+            size_t len    = trace.steps.size();
+            if (trace.finished || (int)len > wanted) {
+                it++;
+                continue;
+            }
+
+            Sudoku next(trace.steps.back());
+            lock.unlock();
+            bool changed = next.calcOneStep(next);
+            lock.lock();
+
+            // show() may have dropped the trace meanwhile
+            auto found = traces.find(puzzle);
+            if (found != traces.end() && found->second.steps.size() == len) {
+                if (changed)
+                    found->second.steps.emplace_back(std::move(next));
+                else
+                    found->second.finished = true;
+                updated = true;
+                anywork = true;
+            }
+            it = traces.upper_bound(puzzle);
+        }
+
+        if (!anywork) wakeup.wait(lock);
+    }
+}
+
+void TraceCache::show(const std::map<size_t, Sudoku> &puzzles) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = traces.begin(); it != traces.end();) {
+            if (puzzles.count(it->first))
+                it++;
+            else
+                it = traces.erase(it);
+        }
+        for (auto &puzzle : puzzles) {
+            if (traces.count(puzzle.first)) continue;
+            traces[puzzle.first].steps.push_back(puzzle.second);
+        }
+        updated = true;
+    }
+    wakeup.notify_all();
+}
+
+void TraceCache::want(int step) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wanted = step;
+    }
+    wakeup.notify_all();
+}
+
+int TraceCache::get(size_t puzzle, int step, Sudoku &dst, bool &finished) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = traces.find(puzzle);
+    if (it == traces.end()) return -1;
+
+    const Trace &trace = it->second;
+    int i              = std::min(step, (int)trace.steps.size() - 1);
+    dst                = trace.steps[i];
+    finished           = trace.finished && i == (int)trace.steps.size() - 1;
+    return i;
+}
+
+bool TraceCache::poll_updated() {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool u  = updated;
+    updated = false;
+    return u;
+}
+
+const static int TILE_ROWS = Board::HEIGHT + 1;  // a title line above each board
+const static int TILE_COLS = Board::WIDTH + 1;
+
+int TileView::tile_cnt() {
+    int rows = std::max(1, (screen.height() - 1) / TILE_ROWS);
+    int cols = std::max(1, screen.width() / TILE_COLS);
+    return rows * cols;
+}
+
+void TileView::load_page() {
+    std::map<size_t, Sudoku> puzzles;
+    char buf[82];
+    for (int i = 0; i < tile_cnt() && corpus.puzzle(first + i, buf); i++) puzzles.emplace(first + i, Sudoku(buf));
+
+    cache.show(puzzles);
+    cache.want(step);
+    screen.clear_screen();
+}
+
+void TileView::draw() {
+    char line[256];
+    char of[32] = "?";
+    char at[32] = "final";
+    size_t last = first + tile_cnt();
+    size_t total;
+    if (corpus.count(total)) {
+        snprintf(of, sizeof(of), "%zu", total);
+        last = std::min(last, total);
+    }
+    if (step != TraceCache::FINAL) snprintf(at, sizeof(at), "%d", step);
+
+    snprintf(line,
+             sizeof(line),
+             "puzzles %zu-%zu of %s, step %s    [n/p] page  [l/h] step  [a] final  [q] quit",
+             first + 1,
+             last,
+             of,
+             at);
+    screen.clear_line(0);
+    screen.draw(0, 0, line, COLOR_INDEX_DEFAULT_COLOR);
+
+    int cols = std::max(1, screen.width() / TILE_COLS);
+    Sudoku sudoku("");
+    for (int i = 0; i < tile_cnt(); i++) {
+        int top  = 1 + (i / cols) * TILE_ROWS;
+        int left = (i % cols) * TILE_COLS;
+
+        bool finished;
+        int shown = cache.get(first + i, step, sudoku, finished);
+        if (shown < 0) continue;
+
+        // padded to the tile width, to overwrite a longer title of a previous page
+        snprintf(line, sizeof(line), "#%zu step %d%s", first + i + 1, shown, finished ? " (end)" : "");
+        snprintf(line + strlen(line), sizeof(line) - strlen(line), "%*s", (int)(Board::WIDTH - strlen(line)), "");
+        screen.draw(top, left, line, finished ? COLOR_INDEX_YELLOW : COLOR_INDEX_DEFAULT_COLOR);
+
+        Board board(screen, top + 1, left);
+        board.draw(sudoku);
+    }
+}
+
+void TileView::run() {
+    screen.set_input_timeout(50);
+    load_page();
+    draw();
+
+    while (true) {
+        int ch = getch();
+
+        if (ch == ERR) {
+            if (cache.poll_updated()) draw();
+            continue;
+        }
+
+        if (ch == 'q') {
+            break;
+        } else if (ch == 'n') {
+            char buf[82];
+            if (!corpus.puzzle(first + tile_cnt(), buf)) continue;
+            first += tile_cnt();
+            step = 0;
+            load_page();
+        } else if (ch == 'p') {
+            if (first == 0) continue;
+            first = first > (size_t)tile_cnt() ? first - tile_cnt() : 0;
+            step  = 0;
+            load_page();
+        } else if (ch == 'l') {
+            if (step != TraceCache::FINAL) step++;
+            cache.want(step);
+        } else if (ch == 'h') {
+            if (step == TraceCache::FINAL) {
+                // back from the end of the longest trace on screen
+                Sudoku sudoku("");
+                bool finished;
+                int longest = 0;
+                for (int i = 0; i < tile_cnt(); i++)
+                    longest = std::max(longest, cache.get(first + i, step, sudoku, finished));
+                step = longest;
+            }
+            if (step > 0) step--;
+        } else if (ch == 'a') {
+            step = TraceCache::FINAL;
+            cache.want(step);
+        } else if (ch == KEY_RESIZE) {
+            load_page();
+        }
+
+        draw();
+    }
+}
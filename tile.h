@@ -0,0 +1,66 @@
+#ifndef TILE_H
+#define TILE_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "corpus.h"
+#include "screen.h"
+#include "sudoku.h"
+
+// Step traces of the puzzles currently on screen, computed lazily on a background thread. Only puzzles passed to
+// show() are kept, and only as many steps as the last wanted step are computed, so paging through a large corpus costs
+// no more than the boards actually looked at.
+class TraceCache {
+    struct Trace {
+        std::vector<Sudoku> steps;
+        bool finished = false;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::map<size_t, Trace> traces;
+    int wanted    = 0;
+    bool stopping = false;
+    bool updated  = false;
+    std::thread worker;
+
+    void work();
+
+public:
+    const static int FINAL = 1 << 30;
+
+    TraceCache();
+    ~TraceCache();
+
+    // Forgets every trace not in `puzzles`; starts the new ones from their givens.
+    void show(const std::map<size_t, Sudoku> &puzzles);
+    // Computes every shown trace up to step `step`, or to its end with FINAL.
+    void want(int step);
+    // Copies the latest computed step not after `step`, returning its index, or -1 if the puzzle is not shown.
+    int get(size_t puzzle, int step, Sudoku &dst, bool &finished);
+    // Whether a step has been computed since the last call.
+    bool poll_updated();
+};
+
+// Tiles as many boards as the terminal fits, paging through a corpus file.
+class TileView {
+    Screen &screen;
+    CorpusFile &corpus;
+    TraceCache cache;
+    size_t first = 0;
+    int step     = 0;
+
+    int tile_cnt();
+    void load_page();
+    void draw();
+
+public:
+    TileView(Screen &screen_, CorpusFile &corpus_) : screen(screen_), corpus(corpus_) {}
+    void run();
+};
+
+#endif  // TILE_H
@@ -0,0 +1,49 @@
+#include "transposition.h"
+
+TranspositionTable::TranspositionTable(int capacity_log2)
+    : entries(new Entry[1ULL << capacity_log2]), mask((1ULL << capacity_log2) - 1) {}
+
+bool TranspositionTable::probe(uint64_t hash, unsigned short candidates[81]) const {
+    const Entry &e = entries[hash & mask];
+
+    uint32_t seq = e.seq.load(std::memory_order_acquire);
+    if (seq == 0 || (seq & 1)) return false;
+    if (e.key.load(std::memory_order_relaxed) != hash) return false;
+
+    uint64_t words[WORDS];
+    for (int i = 0; i < WORDS; i++) words[i] = e.words[i].load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (e.seq.load(std::memory_order_relaxed) != seq) return false;
+
+    // 9 bits per cell, packed back to back
+    for (int i = 0; i < 81; i++) {
+        int bit    = i * 9;
+        uint64_t v = words[bit / 64] >> (bit % 64);
+        if (bit % 64 > 64 - 9) v |= words[bit / 64 + 1] << (64 - bit % 64);
+        candidates[i] = v & 0x1ff;
+    }
+    return true;
+}
+
+void TranspositionTable::store(uint64_t hash, const unsigned short candidates[81]) {
+    Entry &e = entries[hash & mask];
+
+    uint32_t seq = e.seq.load(std::memory_order_relaxed);
+    if (seq & 1) return;
+    if (!e.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) return;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[WORDS] = {};
+    for (int i = 0; i < 81; i++) {
+        int bit    = i * 9;
+        uint64_t v = candidates[i] & 0x1ff;
+        words[bit / 64] |= v << (bit % 64);
+        if (bit % 64 > 64 - 9) words[bit / 64 + 1] |= v >> (64 - bit % 64);
+    }
+
+    e.key.store(hash, std::memory_order_relaxed);
+    for (int i = 0; i < WORDS; i++) e.words[i].store(words[i], std::memory_order_relaxed);
+
+    e.seq.store(seq + 2, std::memory_order_release);
+}
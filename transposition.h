@@ -0,0 +1,32 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+// Bounded map from a candidate state's zobrist hash to the fixpoint that state eventually reaches. Entries are
+// direct-mapped and always replaced, so the table never grows. It is lock free: each entry is guarded by a sequence
+// number (odd while being written), a reader that races with a writer just sees a miss, and a writer that races with
+// another writer drops its store. One table can be shared by any number of solver threads.
+class TranspositionTable {
+    constexpr static int WORDS = (81 * 9 + 63) / 64;
+
+    struct Entry {
+        std::atomic<uint32_t> seq{0};
+        std::atomic<uint64_t> key{0};
+        std::atomic<uint64_t> words[WORDS] = {};
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    const uint64_t mask;
+
+public:
+    explicit TranspositionTable(int capacity_log2 = 16);
+
+    bool probe(uint64_t hash, unsigned short candidates[81]) const;
+    void store(uint64_t hash, const unsigned short candidates[81]);
+};
+
+#endif  // TRANSPOSITION_H